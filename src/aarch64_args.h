@@ -0,0 +1,84 @@
+case 7: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fsetxattr
+case 10: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fgetxattr
+case 13: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // flistxattr
+case 16: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fremovexattr
+case 21: return SYSCALL_ARGS(FD, INT, FD, INT, INT, INT); // epoll_ctl
+case 22: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // epoll_pwait
+case 23: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // dup
+case 24: return SYSCALL_ARGS(FD, FD, INT, INT, INT, INT); // dup3
+case 25: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fcntl
+case 27: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // inotify_add_watch
+case 28: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // inotify_rm_watch
+case 29: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // ioctl
+case 32: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // flock
+case 34: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // mkdirat
+case 35: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // unlinkat
+case 36: return SYSCALL_ARGS(PATH, FD, PATH, INT, INT, INT); // symlinkat
+case 37: return SYSCALL_ARGS(FD, PATH, FD, PATH, INT, INT); // linkat
+case 38: return SYSCALL_ARGS(FD, PATH, FD, PATH, INT, INT); // renameat
+case 43: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // statfs
+case 44: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fstatfs
+case 45: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // truncate
+case 46: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // ftruncate
+case 47: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fallocate
+case 48: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // faccessat
+case 49: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // chdir
+case 50: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fchdir
+case 52: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fchmod
+case 53: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // fchmodat
+case 54: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // fchownat
+case 55: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fchown
+case 56: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // openat
+case 57: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // close
+case 61: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // getdents64
+case 62: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // lseek
+case 63: return SYSCALL_ARGS(FD, BUF_OUT, INT, INT, INT, INT); // read
+case 64: return SYSCALL_ARGS(FD, BUF_IN, INT, INT, INT, INT); // write
+case 65: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // readv
+case 66: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // writev
+case 67: return SYSCALL_ARGS(FD, BUF_OUT, INT, INT, INT, INT); // pread64
+case 68: return SYSCALL_ARGS(FD, BUF_IN, INT, INT, INT, INT); // pwrite64
+case 69: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // preadv
+case 70: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // pwritev
+case 71: return SYSCALL_ARGS(FD, FD, INT, INT, INT, INT); // sendfile
+case 75: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // vmsplice
+case 76: return SYSCALL_ARGS(FD, INT, FD, INT, INT, INT); // splice
+case 77: return SYSCALL_ARGS(FD, FD, INT, INT, INT, INT); // tee
+case 78: return SYSCALL_ARGS(FD, PATH, BUF_OUT, INT, INT, INT); // readlinkat
+case 79: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // newfstatat
+case 80: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fstat
+case 82: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fsync
+case 83: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fdatasync
+case 84: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // sync_file_range
+case 86: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // timerfd_settime
+case 87: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // timerfd_gettime
+case 88: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // utimensat
+case 200: return SYSCALL_ARGS(FD, SOCKADDR, INT, INT, INT, INT); // bind
+case 201: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // listen
+case 202: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // accept
+case 203: return SYSCALL_ARGS(FD, SOCKADDR, INT, INT, INT, INT); // connect
+case 204: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // getsockname
+case 205: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // getpeername
+case 206: return SYSCALL_ARGS(FD, BUF_IN, INT, INT, SOCKADDR, INT); // sendto
+case 207: return SYSCALL_ARGS(FD, BUF_OUT, INT, INT, INT, INT); // recvfrom
+case 208: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // setsockopt
+case 209: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // getsockopt
+case 210: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // shutdown
+case 211: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // sendmsg
+case 212: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // recvmsg
+case 213: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // readahead
+case 221: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // execve
+case 222: return SYSCALL_ARGS(INT, INT, INT, INT, FD, INT); // mmap
+case 223: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fadvise64
+case 242: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // accept4
+case 243: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // recvmmsg
+case 264: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // name_to_handle_at
+case 267: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // syncfs
+case 268: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // setns
+case 269: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // sendmmsg
+case 276: return SYSCALL_ARGS(FD, PATH, FD, PATH, INT, INT); // renameat2
+case 281: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // execveat
+case 285: return SYSCALL_ARGS(FD, INT, FD, INT, INT, INT); // copy_file_range
+case 286: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // preadv2
+case 287: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // pwritev2
+case 291: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // statx
@@ -0,0 +1,172 @@
+case 5: return SYSCALL_CLASS_FILE; // setxattr
+case 6: return SYSCALL_CLASS_FILE; // lsetxattr
+case 7: return SYSCALL_CLASS_DESC; // fsetxattr
+case 8: return SYSCALL_CLASS_FILE; // getxattr
+case 9: return SYSCALL_CLASS_FILE; // lgetxattr
+case 10: return SYSCALL_CLASS_DESC; // fgetxattr
+case 11: return SYSCALL_CLASS_FILE; // listxattr
+case 12: return SYSCALL_CLASS_FILE; // llistxattr
+case 13: return SYSCALL_CLASS_DESC; // flistxattr
+case 14: return SYSCALL_CLASS_FILE; // removexattr
+case 15: return SYSCALL_CLASS_FILE; // lremovexattr
+case 16: return SYSCALL_CLASS_DESC; // fremovexattr
+case 19: return SYSCALL_CLASS_DESC; // eventfd2
+case 20: return SYSCALL_CLASS_DESC; // epoll_create1
+case 21: return SYSCALL_CLASS_DESC; // epoll_ctl
+case 22: return SYSCALL_CLASS_DESC; // epoll_pwait
+case 23: return SYSCALL_CLASS_DESC; // dup
+case 24: return SYSCALL_CLASS_DESC; // dup3
+case 25: return SYSCALL_CLASS_DESC; // fcntl
+case 26: return SYSCALL_CLASS_DESC; // inotify_init1
+case 27: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // inotify_add_watch
+case 28: return SYSCALL_CLASS_DESC; // inotify_rm_watch
+case 29: return SYSCALL_CLASS_DESC; // ioctl
+case 32: return SYSCALL_CLASS_DESC; // flock
+case 33: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // mknodat
+case 34: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // mkdirat
+case 35: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // unlinkat
+case 36: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // symlinkat
+case 37: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // linkat
+case 38: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // renameat
+case 39: return SYSCALL_CLASS_FILE; // umount2
+case 40: return SYSCALL_CLASS_FILE; // mount
+case 41: return SYSCALL_CLASS_FILE; // pivot_root
+case 43: return SYSCALL_CLASS_FILE; // statfs
+case 44: return SYSCALL_CLASS_DESC; // fstatfs
+case 45: return SYSCALL_CLASS_FILE; // truncate
+case 46: return SYSCALL_CLASS_DESC; // ftruncate
+case 47: return SYSCALL_CLASS_DESC; // fallocate
+case 48: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // faccessat
+case 49: return SYSCALL_CLASS_FILE; // chdir
+case 50: return SYSCALL_CLASS_DESC; // fchdir
+case 51: return SYSCALL_CLASS_FILE; // chroot
+case 52: return SYSCALL_CLASS_DESC; // fchmod
+case 53: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // fchmodat
+case 54: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // fchownat
+case 55: return SYSCALL_CLASS_DESC; // fchown
+case 56: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // openat
+case 57: return SYSCALL_CLASS_DESC; // close
+case 59: return SYSCALL_CLASS_DESC; // pipe2
+case 60: return SYSCALL_CLASS_FILE; // quotactl
+case 61: return SYSCALL_CLASS_DESC; // getdents64
+case 62: return SYSCALL_CLASS_DESC; // lseek
+case 63: return SYSCALL_CLASS_DESC; // read
+case 64: return SYSCALL_CLASS_DESC; // write
+case 65: return SYSCALL_CLASS_DESC; // readv
+case 66: return SYSCALL_CLASS_DESC; // writev
+case 67: return SYSCALL_CLASS_DESC; // pread64
+case 68: return SYSCALL_CLASS_DESC; // pwrite64
+case 69: return SYSCALL_CLASS_DESC; // preadv
+case 70: return SYSCALL_CLASS_DESC; // pwritev
+case 71: return SYSCALL_CLASS_DESC; // sendfile
+case 72: return SYSCALL_CLASS_DESC; // pselect6
+case 73: return SYSCALL_CLASS_DESC; // ppoll
+case 74: return SYSCALL_CLASS_DESC | SYSCALL_CLASS_SIGNAL; // signalfd4
+case 75: return SYSCALL_CLASS_DESC; // vmsplice
+case 76: return SYSCALL_CLASS_DESC; // splice
+case 77: return SYSCALL_CLASS_DESC; // tee
+case 78: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // readlinkat
+case 79: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // newfstatat
+case 80: return SYSCALL_CLASS_DESC; // fstat
+case 82: return SYSCALL_CLASS_DESC; // fsync
+case 83: return SYSCALL_CLASS_DESC; // fdatasync
+case 84: return SYSCALL_CLASS_DESC; // sync_file_range
+case 85: return SYSCALL_CLASS_DESC; // timerfd_create
+case 86: return SYSCALL_CLASS_DESC; // timerfd_settime
+case 87: return SYSCALL_CLASS_DESC; // timerfd_gettime
+case 88: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // utimensat
+case 89: return SYSCALL_CLASS_FILE; // acct
+case 93: return SYSCALL_CLASS_PROCESS; // exit
+case 94: return SYSCALL_CLASS_PROCESS; // exit_group
+case 95: return SYSCALL_CLASS_PROCESS; // waitid
+case 97: return SYSCALL_CLASS_PROCESS; // unshare
+case 129: return SYSCALL_CLASS_PROCESS | SYSCALL_CLASS_SIGNAL; // kill
+case 130: return SYSCALL_CLASS_PROCESS | SYSCALL_CLASS_SIGNAL; // tkill
+case 131: return SYSCALL_CLASS_PROCESS | SYSCALL_CLASS_SIGNAL; // tgkill
+case 132: return SYSCALL_CLASS_SIGNAL; // sigaltstack
+case 133: return SYSCALL_CLASS_SIGNAL; // rt_sigsuspend
+case 134: return SYSCALL_CLASS_SIGNAL; // rt_sigaction
+case 135: return SYSCALL_CLASS_SIGNAL; // rt_sigprocmask
+case 136: return SYSCALL_CLASS_SIGNAL; // rt_sigpending
+case 137: return SYSCALL_CLASS_SIGNAL; // rt_sigtimedwait
+case 138: return SYSCALL_CLASS_PROCESS | SYSCALL_CLASS_SIGNAL; // rt_sigqueueinfo
+case 139: return SYSCALL_CLASS_SIGNAL; // rt_sigreturn
+case 180: return SYSCALL_CLASS_IPC; // mq_open
+case 181: return SYSCALL_CLASS_IPC; // mq_unlink
+case 182: return SYSCALL_CLASS_IPC; // mq_timedsend
+case 183: return SYSCALL_CLASS_IPC; // mq_timedreceive
+case 184: return SYSCALL_CLASS_IPC; // mq_notify
+case 185: return SYSCALL_CLASS_IPC; // mq_getsetattr
+case 186: return SYSCALL_CLASS_IPC; // msgget
+case 187: return SYSCALL_CLASS_IPC; // msgctl
+case 188: return SYSCALL_CLASS_IPC; // msgrcv
+case 189: return SYSCALL_CLASS_IPC; // msgsnd
+case 190: return SYSCALL_CLASS_IPC; // semget
+case 191: return SYSCALL_CLASS_IPC; // semctl
+case 192: return SYSCALL_CLASS_IPC; // semtimedop
+case 193: return SYSCALL_CLASS_IPC; // semop
+case 194: return SYSCALL_CLASS_IPC; // shmget
+case 195: return SYSCALL_CLASS_IPC; // shmctl
+case 196: return SYSCALL_CLASS_IPC; // shmat
+case 197: return SYSCALL_CLASS_IPC; // shmdt
+case 198: return SYSCALL_CLASS_NETWORK; // socket
+case 199: return SYSCALL_CLASS_NETWORK; // socketpair
+case 200: return SYSCALL_CLASS_NETWORK; // bind
+case 201: return SYSCALL_CLASS_NETWORK; // listen
+case 202: return SYSCALL_CLASS_NETWORK; // accept
+case 203: return SYSCALL_CLASS_NETWORK; // connect
+case 204: return SYSCALL_CLASS_NETWORK; // getsockname
+case 205: return SYSCALL_CLASS_NETWORK; // getpeername
+case 206: return SYSCALL_CLASS_NETWORK; // sendto
+case 207: return SYSCALL_CLASS_NETWORK; // recvfrom
+case 208: return SYSCALL_CLASS_NETWORK; // setsockopt
+case 209: return SYSCALL_CLASS_NETWORK; // getsockopt
+case 210: return SYSCALL_CLASS_NETWORK; // shutdown
+case 211: return SYSCALL_CLASS_NETWORK; // sendmsg
+case 212: return SYSCALL_CLASS_NETWORK; // recvmsg
+case 213: return SYSCALL_CLASS_DESC; // readahead
+case 214: return SYSCALL_CLASS_MEMORY; // brk
+case 215: return SYSCALL_CLASS_MEMORY; // munmap
+case 216: return SYSCALL_CLASS_MEMORY; // mremap
+case 220: return SYSCALL_CLASS_PROCESS; // clone
+case 221: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_PROCESS; // execve
+case 222: return SYSCALL_CLASS_DESC | SYSCALL_CLASS_MEMORY; // mmap
+case 223: return SYSCALL_CLASS_DESC; // fadvise64
+case 224: return SYSCALL_CLASS_FILE; // swapon
+case 225: return SYSCALL_CLASS_FILE; // swapoff
+case 226: return SYSCALL_CLASS_MEMORY; // mprotect
+case 227: return SYSCALL_CLASS_MEMORY; // msync
+case 228: return SYSCALL_CLASS_MEMORY; // mlock
+case 229: return SYSCALL_CLASS_MEMORY; // munlock
+case 230: return SYSCALL_CLASS_MEMORY; // mlockall
+case 231: return SYSCALL_CLASS_MEMORY; // munlockall
+case 232: return SYSCALL_CLASS_MEMORY; // mincore
+case 233: return SYSCALL_CLASS_MEMORY; // madvise
+case 234: return SYSCALL_CLASS_MEMORY; // remap_file_pages
+case 235: return SYSCALL_CLASS_MEMORY; // mbind
+case 236: return SYSCALL_CLASS_MEMORY; // get_mempolicy
+case 237: return SYSCALL_CLASS_MEMORY; // set_mempolicy
+case 238: return SYSCALL_CLASS_MEMORY; // migrate_pages
+case 239: return SYSCALL_CLASS_MEMORY; // move_pages
+case 240: return SYSCALL_CLASS_PROCESS | SYSCALL_CLASS_SIGNAL; // rt_tgsigqueueinfo
+case 242: return SYSCALL_CLASS_NETWORK; // accept4
+case 243: return SYSCALL_CLASS_NETWORK; // recvmmsg
+case 260: return SYSCALL_CLASS_PROCESS; // wait4
+case 262: return SYSCALL_CLASS_DESC; // fanotify_init
+case 263: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // fanotify_mark
+case 264: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // name_to_handle_at
+case 265: return SYSCALL_CLASS_DESC; // open_by_handle_at
+case 267: return SYSCALL_CLASS_DESC; // syncfs
+case 268: return SYSCALL_CLASS_DESC; // setns
+case 269: return SYSCALL_CLASS_NETWORK; // sendmmsg
+case 273: return SYSCALL_CLASS_DESC; // finit_module
+case 276: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // renameat2
+case 279: return SYSCALL_CLASS_DESC; // memfd_create
+case 281: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC | SYSCALL_CLASS_PROCESS; // execveat
+case 284: return SYSCALL_CLASS_MEMORY; // mlock2
+case 285: return SYSCALL_CLASS_DESC; // copy_file_range
+case 286: return SYSCALL_CLASS_DESC; // preadv2
+case 287: return SYSCALL_CLASS_DESC; // pwritev2
+case 288: return SYSCALL_CLASS_MEMORY; // pkey_mprotect
+case 291: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // statx
+case 436: return SYSCALL_CLASS_DESC; // close_range
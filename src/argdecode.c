@@ -0,0 +1,292 @@
+#define _GNU_SOURCE // process_vm_readv()
+#include "argdecode.h"
+#include "parser.h"
+#include "fdtable.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#define ALIGN8(n) (((size_t) (n) + 7) & ~(size_t) 7)
+
+// Cada argumento é copiado em até dois trechos (ver copy_args())
+#define ARGDECODE_SEGMENTS 12
+
+struct arg_arena {
+    uint32_t used;   // Bytes de payload prontos no início de data
+    uint32_t reserved;
+    uint8_t data[];  // Alinhado em 8 bytes, como o payload no arquivo
+};
+
+// Um argumento a copiar da memória da thread
+struct arg_copy {
+    int arg;
+    int kind;
+    uint64_t addr;
+    size_t want;            // Bytes pedidos
+    int truncated;          // O tamanho real passa do limite de cópia
+    struct trace_arg *hdr;  // Posição reservada na arena
+    size_t got;             // Bytes copiados
+};
+
+static int enabled = 0;
+static int decode_pointers = 0;
+static int annotate_fds = 0;
+static uint32_t data_cap = 0;
+static size_t arena_size = 0;
+static uintptr_t page_size = 4096;
+
+void argdecode_init(int pointers, uint32_t cap, int fds) {
+    long page = sysconf(_SC_PAGESIZE);
+
+    enabled = 1;
+    decode_pointers = pointers;
+    annotate_fds = fds;
+    data_cap = pointers ? cap : 0;
+    arena_size = 0;
+    if (pointers) {
+        // Cada syscall das tabelas tem no máximo dois caminhos (rename, linkat...),
+        // um buffer e um endereço, mas eles se combinam (caminho e buffer em
+        // readlinkat, buffer e endereço em sendto): reserva todos
+        arena_size = 2 * (sizeof(struct trace_arg) + ALIGN8(ARGDECODE_PATH_MAX)) +
+                     sizeof(struct trace_arg) + ALIGN8(cap) +
+                     sizeof(struct trace_arg) + ALIGN8(ARGDECODE_SOCKADDR_MAX);
+    }
+    if (fds) {
+        // Até três descritores nos argumentos (epoll_ctl, splice...) e o do retorno;
+        // reserva os sete para não depender das tabelas
+        arena_size += 7 * (sizeof(struct trace_arg) + ALIGN8(ARGDECODE_PATH_MAX));
+    }
+    if (page > 0) {
+        page_size = (uintptr_t) page;
+    }
+}
+
+int argdecode_enabled(void) {
+    return enabled;
+}
+
+/**
+ * @brief Reserva a arena da thread (na primeira syscall decodificada).
+ */
+static struct arg_arena *arena_of(struct tracee *t) {
+    if (!t->args) {
+        t->args = malloc(sizeof(*t->args) + arena_size);
+        if (t->args) {
+            t->args->used = 0;
+        }
+    }
+    return t->args;
+}
+
+/**
+ * @brief Acrescenta ao payload o que o descritor fd é (-y).
+ */
+static void add_fd(struct tracee *t, int arg, int64_t fd) {
+    struct arg_arena *a = arena_of(t);
+    struct trace_arg *hdr;
+    const char *desc;
+    uint32_t len;
+
+    if (!a || !(desc = fdtable_describe(t, fd, &len))) {
+        return;
+    }
+    if (a->used + sizeof(*hdr) + ALIGN8(ARGDECODE_PATH_MAX) > arena_size) {
+        return;
+    }
+    hdr = (struct trace_arg *) (a->data + a->used);
+    hdr->arg = (uint8_t) arg;
+    hdr->kind = TRACE_ARG_FD;
+    hdr->truncated = len > ARGDECODE_PATH_MAX;
+    hdr->reserved = 0;
+    hdr->len = len < ARGDECODE_PATH_MAX ? len : ARGDECODE_PATH_MAX;
+    memcpy(hdr + 1, desc, hdr->len);
+    memset((uint8_t *) (hdr + 1) + hdr->len, 0, ALIGN8(hdr->len) - hdr->len);
+    a->used += (uint32_t) (sizeof(*hdr) + ALIGN8(hdr->len));
+}
+
+/**
+ * @brief Copia os argumentos com process_vm_readv() e os compacta no fim do payload.
+ *
+ * Um caminho não tem tamanho conhecido: são pedidos ARGDECODE_PATH_MAX bytes,
+ * divididos no fim da página do início da string. Os primeiros trechos de
+ * todos os argumentos vêm antes dos segundos, porque a cópia para no primeiro
+ * trecho inválido: uma string curta no fim de uma região mapeada não impede a
+ * cópia dos outros argumentos. Trechos inválidos são pulados com uma nova chamada.
+ */
+static void copy_args(struct tracee *t, struct arg_copy *c, int n) {
+    struct iovec local[ARGDECODE_SEGMENTS];
+    struct iovec remote[ARGDECODE_SEGMENTS];
+    int owner[ARGDECODE_SEGMENTS];
+    int first[ARGDECODE_SEGMENTS];   // 1 no primeiro trecho de cada argumento
+    int ok[6] = { 0 };
+    int segments = 0;
+    size_t off, end;
+    struct arg_arena *a = arena_of(t);
+
+    if (!a) {
+        return;
+    }
+
+    // Reserva espaço para cada argumento depois do payload já pronto
+    off = a->used;
+    for (int k = 0; k < n; k++) {
+        size_t need = sizeof(struct trace_arg) + ALIGN8(c[k].want);
+        if (off + need > arena_size) {
+            n = k;
+            break;
+        }
+        c[k].hdr = (struct trace_arg *) (a->data + off);
+        c[k].got = 0;
+        off += need;
+    }
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (int k = 0; k < n; k++) {
+            size_t head = c[k].want;
+            if (c[k].kind == TRACE_ARG_PATH) {
+                size_t to_page_end = page_size - (uintptr_t) (c[k].addr & (page_size - 1));
+                head = head < to_page_end ? head : to_page_end;
+            }
+            size_t len = pass == 0 ? head : c[k].want - head;
+            if (len == 0) {
+                continue;
+            }
+            local[segments].iov_base = (uint8_t *) (c[k].hdr + 1) + (pass == 0 ? 0 : head);
+            local[segments].iov_len = len;
+            remote[segments].iov_base = (void *) (uintptr_t) (c[k].addr + (pass == 0 ? 0 : head));
+            remote[segments].iov_len = len;
+            owner[segments] = k;
+            first[segments] = pass == 0;
+            segments++;
+        }
+    }
+
+    // Normalmente uma chamada só; cada trecho inválido custa mais uma
+    for (int s = 0; s < segments;) {
+        ssize_t got = process_vm_readv(t->tid, &local[s], (unsigned long) (segments - s),
+                                       &remote[s], (unsigned long) (segments - s), 0);
+        if (got < 0 && errno != EFAULT) {
+            break; // Thread morta (ESRCH) ou sem permissão: fica sem os argumentos
+        }
+        while (got > 0 && s < segments && (size_t) got >= local[s].iov_len) {
+            int k = owner[s];
+            // O segundo trecho só conta se o primeiro foi copiado
+            if (first[s] || ok[k]) {
+                c[k].got += local[s].iov_len;
+                ok[k] = 1;
+            }
+            got -= (ssize_t) local[s].iov_len;
+            s++;
+        }
+        s++; // Trecho que falhou
+    }
+
+    // Compacta: cada argumento ocupa só o que foi de fato copiado
+    end = a->used;
+    for (int k = 0; k < n; k++) {
+        uint8_t *src = (uint8_t *) (c[k].hdr + 1);
+        uint8_t *dst = a->data + end;
+        size_t len = c[k].got;
+        int truncated = c[k].truncated;
+
+        if (len == 0 && c[k].want > 0) {
+            continue; // Ponteiro inválido: fica só o valor numérico
+        }
+        if (c[k].kind == TRACE_ARG_PATH) {
+            len = strnlen((const char *) src, c[k].got);
+            truncated = len == c[k].got; // Sem o '\0' dentro do que foi copiado
+        }
+        memmove(dst + sizeof(struct trace_arg), src, len);
+        memset(dst + sizeof(struct trace_arg) + len, 0, ALIGN8(len) - len);
+        ((struct trace_arg *) dst)->arg = (uint8_t) c[k].arg;
+        ((struct trace_arg *) dst)->kind = (uint8_t) c[k].kind;
+        ((struct trace_arg *) dst)->truncated = (uint8_t) truncated;
+        ((struct trace_arg *) dst)->reserved = 0;
+        ((struct trace_arg *) dst)->len = (uint32_t) len;
+        end += sizeof(struct trace_arg) + ALIGN8(len);
+    }
+    a->used = (uint32_t) end;
+}
+
+/**
+ * @brief Prepara a cópia de um buffer cujo tamanho real é size.
+ */
+static void plan_buffer(struct arg_copy *c, int arg, int kind, uint64_t addr, uint64_t size, uint32_t cap) {
+    c->arg = arg;
+    c->kind = kind;
+    c->addr = addr;
+    c->want = size < cap ? (size_t) size : cap;
+    c->truncated = size > cap;
+}
+
+void argdecode_entry(struct tracee *t) {
+    unsigned int types = get_syscall_arg_types(t->rec.nr);
+    struct arg_copy c[6];
+    int n = 0;
+
+    // A arena é da thread e dura enquanto ela for rastreada: só é zerada
+    if (t->args) {
+        t->args->used = 0;
+    }
+    if (types == 0) {
+        return;
+    }
+
+    for (int i = 0; i < 6; i++) {
+        int kind = SYSCALL_ARG_TYPE(types, i);
+        uint64_t addr = t->rec.args[i];
+
+        if (kind == TRACE_ARG_FD) {
+            // Antes da syscall: close(3) mostra o que está sendo fechado
+            if (annotate_fds) {
+                add_fd(t, i, (int) addr);
+            }
+            continue;
+        }
+        if (!decode_pointers || kind == TRACE_ARG_INT || kind == TRACE_ARG_BUF_OUT || addr == 0) {
+            continue;
+        }
+        if (kind == TRACE_ARG_PATH) {
+            plan_buffer(&c[n++], i, kind, addr, ARGDECODE_PATH_MAX, ARGDECODE_PATH_MAX);
+        } else if (kind == TRACE_ARG_SOCKADDR) {
+            plan_buffer(&c[n++], i, kind, addr, t->rec.args[i + 1], ARGDECODE_SOCKADDR_MAX);
+        } else if (data_cap > 0) {
+            plan_buffer(&c[n++], i, kind, addr, t->rec.args[i + 1], data_cap);
+        }
+    }
+    if (n > 0) {
+        copy_args(t, c, n);
+    }
+}
+
+void argdecode_exit(struct tracee *t, int ret_is_fd) {
+    unsigned int types = get_syscall_arg_types(t->rec.nr);
+    struct arg_copy c[6];
+    int n = 0;
+
+    if (ret_is_fd && annotate_fds) {
+        add_fd(t, TRACE_ARG_RET, t->rec.ret);
+    }
+    // Só agora o kernel preencheu o buffer; o retorno diz quantos bytes valem
+    if (data_cap == 0 || t->rec.ret <= 0) {
+        return;
+    }
+    for (int i = 0; i < 6; i++) {
+        if (SYSCALL_ARG_TYPE(types, i) == TRACE_ARG_BUF_OUT && t->rec.args[i] != 0) {
+            plan_buffer(&c[n++], i, TRACE_ARG_BUF_OUT, t->rec.args[i], (uint64_t) t->rec.ret, data_cap);
+        }
+    }
+    if (n > 0) {
+        copy_args(t, c, n);
+    }
+}
+
+uint32_t argdecode_payload(const struct tracee *t, const void **payload) {
+    if (!t->args || t->args->used == 0) {
+        return 0;
+    }
+    *payload = t->args->data;
+    return t->args->used;
+}
@@ -0,0 +1,37 @@
+#include <stdint.h>
+#include "tracee_table.h"
+
+#ifndef ARGDECODE_H
+#define ARGDECODE_H
+
+// Decodificação dos argumentos de ponteiro (-a N): caminhos, dados de
+// read/write (até N bytes) e endereços de socket, conforme os tipos de
+// get_syscall_arg_types(). Os dados são copiados da memória da thread com
+// process_vm_readv(), numa única chamada por parada, para a arena da própria
+// thread, que é reaproveitada (zerada) a cada syscall em vez de liberada.
+// O conteúdo da arena é o payload do registro (ver struct trace_arg).
+// Com -y, os argumentos que são descritores (e o retorno de open, socket,
+// dup...) levam junto o que o descritor é, segundo a tabela de fdtable.h.
+
+#define ARGDECODE_PATH_MAX 256      // Bytes copiados de cada caminho
+#define ARGDECODE_SOCKADDR_MAX 128  // sizeof(struct sockaddr_storage)
+#define ARGDECODE_DATA_MAX 4096     // Maior N aceito em -a
+
+// pointers: decodifica os ponteiros (-a), copiando até data_cap bytes de
+// cada buffer de dados (0 copia só caminhos e endereços).
+// fds: anota os descritores (-y).
+void argdecode_init(int pointers, uint32_t data_cap, int fds);
+int argdecode_enabled(void);
+
+// Na parada de entrada: zera a arena, anota os descritores e copia os
+// argumentos lidos pelo kernel
+void argdecode_entry(struct tracee *t);
+
+// Na parada de saída: acrescenta os buffers preenchidos pelo kernel (read...)
+// e, se ret_is_fd, o descritor devolvido
+void argdecode_exit(struct tracee *t, int ret_is_fd);
+
+// Payload da syscall em andamento; retorna o tamanho (0 se não há nada)
+uint32_t argdecode_payload(const struct tracee *t, const void **payload);
+
+#endif
@@ -0,0 +1,169 @@
+#include "attach.h"
+#include "tracee_table.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <dirent.h>
+#include <signal.h>
+#include <sys/ptrace.h>
+#include <sys/wait.h>
+
+/**
+ * @brief Indica se o sinal de uma PTRACE_EVENT_STOP é de uma group-stop (SIGSTOP e afins).
+ */
+static int is_group_stop(int sig) {
+    return sig == SIGSTOP || sig == SIGTSTP || sig == SIGTTIN || sig == SIGTTOU;
+}
+
+/**
+ * @brief Espera a parada do PTRACE_INTERRUPT de uma thread e a retoma com PTRACE_SYSCALL.
+ * Outras paradas que cheguem antes (sinais, clone) são tratadas e a espera continua.
+ */
+static void finish_attach(pid_t tid) {
+    int status;
+
+    while (1) {
+        if (waitpid(tid, &status, __WALL) == -1) {
+            if (errno == EINTR)
+                continue;
+            tracee_remove(tid);
+            return;
+        }
+        if (WIFEXITED(status) || WIFSIGNALED(status)) {
+            tracee_remove(tid);
+            return;
+        }
+
+        int sig = WSTOPSIG(status);
+        int event = status >> 16;
+
+        if (event == PTRACE_EVENT_STOP) {
+            tracee_find(tid)->attach_pending = 0;
+            if (is_group_stop(sig)) {
+                // O processo já estava parado (SIGSTOP): continua parado, mas observado
+                ptrace(PTRACE_LISTEN, tid, NULL, NULL);
+            } else {
+                ptrace(PTRACE_SYSCALL, tid, NULL, NULL);
+            }
+            return;
+        }
+
+        if (event == PTRACE_EVENT_CLONE || event == PTRACE_EVENT_FORK || event == PTRACE_EVENT_VFORK) {
+            // A thread nova já nasce rastreada; sua primeira parada vai para o loop principal
+            unsigned long new_tid;
+            ptrace(PTRACE_GETEVENTMSG, tid, NULL, &new_tid);
+            tracee_add((pid_t) new_tid)->attach_pending = 1;
+            ptrace(PTRACE_CONT, tid, NULL, NULL);
+        } else if (event != 0 || sig == SIGTRAP) {
+            ptrace(PTRACE_CONT, tid, NULL, NULL);
+        } else {
+            ptrace(PTRACE_CONT, tid, NULL, sig); // Sinal comum: repassa
+        }
+    }
+}
+
+int attach_process(pid_t pid, long options) {
+    char path[64];
+    int attached = 0;
+    int found_new;
+
+    // Threads criadas por outras threads ainda não anexadas escapam do
+    // PTRACE_O_TRACECLONE, então a lista é relida até não aparecer nenhuma nova.
+    do {
+        DIR *dir;
+        struct dirent *entry;
+
+        found_new = 0;
+        snprintf(path, sizeof(path), "/proc/%d/task", (int) pid);
+        dir = opendir(path);
+        if (!dir) {
+            if (attached == 0) {
+                perror(path);
+                return -1;
+            }
+            break; // O processo terminou durante o attach
+        }
+
+        while ((entry = readdir(dir)) != NULL) {
+            pid_t tid = (pid_t) atoi(entry->d_name);
+            if (tid <= 0 || tracee_find(tid)) {
+                continue;
+            }
+            if (ptrace(PTRACE_SEIZE, tid, NULL, options) == -1) {
+                if (errno == ESRCH)
+                    continue; // A thread terminou entre o readdir() e o seize
+                perror("PTRACE_SEIZE");
+                closedir(dir);
+                return attached > 0 ? attached : -1;
+            }
+            struct tracee *t = tracee_add(tid);
+            t->attach_pending = 1;
+            t->tgid = pid;
+            ptrace(PTRACE_INTERRUPT, tid, NULL, NULL);
+            finish_attach(tid);
+            attached++;
+            found_new = 1;
+        }
+        closedir(dir);
+    } while (found_new);
+
+    return attached;
+}
+
+void detach_all(void) {
+    int n = tracee_count();
+    pid_t *tids = malloc(sizeof(pid_t) * (n > 0 ? n : 1));
+    int status;
+
+    if (!tids) {
+        return;
+    }
+    n = tracee_tids(tids, n);
+
+    // Interrompe todas primeiro e só depois espera: as threads param em paralelo
+    for (int i = 0; i < n; i++) {
+        ptrace(PTRACE_INTERRUPT, tids[i], NULL, NULL);
+    }
+
+    for (int i = 0; i < n; i++) {
+        struct tracee *t = tracee_find(tids[i]);
+        // O SIGSTOP enviado pela amostragem (-w) ainda não foi consumido: não
+        // pode ser devolvido no detach, senão o processo fica parado
+        int wake = t && t->wake_pending;
+        int interrupted = 0;
+
+        while (waitpid(tids[i], &status, __WALL) != -1) {
+            if (WIFEXITED(status) || WIFSIGNALED(status)) {
+                break;
+            }
+            int sig = WSTOPSIG(status);
+            int event = status >> 16;
+            // Um sinal comum que chegou antes da interrupção é devolvido no detach
+            int deliver = (event == 0 && sig != SIGTRAP && sig != (SIGTRAP | 0x80)) ? sig : 0;
+            if (wake && sig == SIGSTOP && event == 0) {
+                // Descarta o SIGSTOP e espera a parada do PTRACE_INTERRUPT (se ela
+                // já veio, solta a thread aqui mesmo, sem sinal). A interrupção é
+                // repetida: a pedida com a thread já parada neste sinal se perde.
+                t->wake_pending = 0;
+                wake = 0;
+                deliver = 0;
+                if (!interrupted) {
+                    ptrace(PTRACE_CONT, tids[i], NULL, 0);
+                    ptrace(PTRACE_INTERRUPT, tids[i], NULL, NULL);
+                    continue;
+                }
+            } else if (wake) {
+                // O SIGSTOP continua pendente: deixa a thread andar até ele para
+                // descartá-lo (outros sinais são entregues no caminho)
+                interrupted |= event == PTRACE_EVENT_STOP;
+                ptrace(PTRACE_CONT, tids[i], NULL, deliver);
+                continue;
+            }
+            if (ptrace(PTRACE_DETACH, tids[i], NULL, deliver) == 0 || errno == ESRCH) {
+                break;
+            }
+        }
+        tracee_remove(tids[i]);
+    }
+    free(tids);
+}
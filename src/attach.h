@@ -0,0 +1,16 @@
+#include <sys/types.h>
+
+#ifndef ATTACH_H
+#define ATTACH_H
+
+// Anexa o logger a um processo já em execução (-p): todas as threads listadas
+// em /proc/<pid>/task são capturadas com PTRACE_SEIZE + PTRACE_INTERRUPT e
+// retomadas com PTRACE_SYSCALL, uma de cada vez, para que cada thread fique
+// parada pelo menor tempo possível. Retorna a quantidade de threads anexadas
+// ou -1 em caso de erro.
+int attach_process(pid_t pid, long options);
+
+// Solta todas as threads rastreadas, que continuam rodando sem o logger.
+void detach_all(void);
+
+#endif
@@ -0,0 +1,313 @@
+#include "columnar.h"
+#include "varint.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// O índice de nr no dicionário ocupa um byte
+#define COL_DICT_MAX 256
+// Pior caso de uma coluna codificada (o dicionário de nr, mais os índices, cabe nisso)
+#define COL_COLUMN_MAX (COL_BLOCK_EVENTS * VARINT_MAX + COL_DICT_MAX * VARINT_MAX + VARINT_MAX)
+// Números de syscall com posição direta no mapa do dicionário (os outros são procurados)
+#define COL_DICT_DENSE 1024
+
+const char *const col_names[COL_COUNT] = {
+    "ts", "tid", "nr", "ret", "dur", "flags", "arg1", "arg2", "arg3", "arg4", "arg5", "arg6",
+};
+
+struct col_writer {
+    FILE *f;
+    int failed;
+    uint32_t events;
+    int dict_len;
+    int32_t dict[COL_DICT_MAX];
+    int16_t dict_index[COL_DICT_DENSE]; // -1: número fora do dicionário
+    uint8_t nr_index[COL_BLOCK_EVENTS];
+    struct trace_record recs[COL_BLOCK_EVENTS];
+    uint8_t buf[COL_COUNT][COL_COLUMN_MAX]; // Colunas codificadas do bloco
+};
+
+int col_by_name(const char *name) {
+    for (int i = 0; i < COL_COUNT; i++) {
+        if (strcmp(col_names[i], name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Valor da coluna col de um registro (ret convertido para uint64_t).
+ */
+static uint64_t col_value(const struct trace_record *rec, int col) {
+    switch (col) {
+    case COL_TS:    return rec->ts_ns;
+    case COL_TID:   return rec->tid;
+    case COL_NR:    return (uint64_t) (int64_t) rec->nr;
+    case COL_RET:   return (uint64_t) rec->ret;
+    case COL_DUR:   return rec->dur_ns;
+    case COL_FLAGS: return rec->flags;
+    default:        return rec->args[col - COL_ARG1];
+    }
+}
+
+/**
+ * @brief Codifica a coluna col do bloco em w->buf[col] e preenche suas estatísticas.
+ */
+static void encode_column(struct col_writer *w, int col, struct col_stats *st) {
+    uint8_t *p = w->buf[col];
+    uint64_t prev = 0;
+
+    st->min = st->max = col_value(&w->recs[0], col);
+    for (uint32_t i = 0; i < w->events; i++) {
+        uint64_t v = col_value(&w->recs[i], col);
+        if (col == COL_RET || col == COL_NR) {
+            st->min = (int64_t) v < (int64_t) st->min ? v : st->min;
+            st->max = (int64_t) v > (int64_t) st->max ? v : st->max;
+        } else {
+            st->min = v < st->min ? v : st->min;
+            st->max = v > st->max ? v : st->max;
+        }
+    }
+
+    if (col == COL_NR) {
+        // Dicionário e um byte por syscall
+        p = put_varint(p, (uint64_t) w->dict_len);
+        for (int d = 0; d < w->dict_len; d++) {
+            p = put_varint(p, zigzag(w->dict[d]));
+        }
+        memcpy(p, w->nr_index, w->events);
+        p += w->events;
+    } else if (col == COL_DUR || col == COL_FLAGS) {
+        for (uint32_t i = 0; i < w->events; i++) {
+            p = put_varint(p, col_value(&w->recs[i], col));
+        }
+    } else if (col == COL_RET) {
+        for (uint32_t i = 0; i < w->events; i++) {
+            p = put_varint(p, zigzag(w->recs[i].ret));
+        }
+    } else {
+        // ts, tid e argumentos: diferença para a syscall anterior
+        for (uint32_t i = 0; i < w->events; i++) {
+            uint64_t v = col_value(&w->recs[i], col);
+            p = put_varint(p, zigzag((int64_t) (v - prev)));
+            prev = v;
+        }
+    }
+    st->size = (uint32_t) (p - w->buf[col]);
+    st->reserved = 0;
+}
+
+/**
+ * @brief Grava o bloco acumulado: o cabeçalho com as estatísticas e as colunas.
+ */
+static void flush_block(struct col_writer *w) {
+    struct col_block_header bh;
+
+    if (w->events == 0) {
+        return;
+    }
+    bh.events = w->events;
+    bh.columns = COL_COUNT;
+    for (int c = 0; c < COL_COUNT; c++) {
+        encode_column(w, c, &bh.stats[c]);
+    }
+    if (fwrite(&bh, sizeof(bh), 1, w->f) != 1) {
+        w->failed = 1;
+    }
+    for (int c = 0; c < COL_COUNT; c++) {
+        if (fwrite(w->buf[c], 1, bh.stats[c].size, w->f) != bh.stats[c].size) {
+            w->failed = 1;
+        }
+    }
+
+    w->events = 0;
+    for (int d = 0; d < w->dict_len; d++) {
+        if (w->dict[d] >= 0 && w->dict[d] < COL_DICT_DENSE) {
+            w->dict_index[w->dict[d]] = -1;
+        }
+    }
+    w->dict_len = 0;
+}
+
+/**
+ * @brief Posição de nr no dicionário do bloco; -1 se ele não está lá.
+ */
+static int dict_find(const struct col_writer *w, int32_t nr) {
+    if (nr >= 0 && nr < COL_DICT_DENSE) {
+        return w->dict_index[nr];
+    }
+    for (int d = 0; d < w->dict_len; d++) {
+        if (w->dict[d] == nr) {
+            return d;
+        }
+    }
+    return -1;
+}
+
+struct col_writer *col_writer_open(const char *path, const struct trace_file_header *hdr) {
+    struct col_writer *w = malloc(sizeof(*w));
+    struct trace_file_header out = *hdr;
+
+    if (!w) {
+        return NULL;
+    }
+    w->f = fopen(path, "wb");
+    if (!w->f) {
+        free(w);
+        return NULL;
+    }
+    w->failed = 0;
+    w->events = 0;
+    w->dict_len = 0;
+    memset(w->dict_index, 0xff, sizeof(w->dict_index));
+
+    memcpy(out.magic, COL_MAGIC, sizeof(out.magic));
+    out.version = COL_VERSION;
+    if (fwrite(&out, sizeof(out), 1, w->f) != 1) {
+        w->failed = 1;
+    }
+    return w;
+}
+
+int col_writer_add(struct col_writer *w, const struct trace_record *rec) {
+    int d = dict_find(w, rec->nr);
+
+    if (d == -1) {
+        // Dicionário cheio: o bloco termina antes
+        if (w->dict_len == COL_DICT_MAX) {
+            flush_block(w);
+        }
+        d = w->dict_len++;
+        w->dict[d] = rec->nr;
+        if (rec->nr >= 0 && rec->nr < COL_DICT_DENSE) {
+            w->dict_index[rec->nr] = (int16_t) d;
+        }
+    }
+    w->recs[w->events] = *rec;
+    w->nr_index[w->events] = (uint8_t) d;
+    if (++w->events == COL_BLOCK_EVENTS) {
+        flush_block(w);
+    }
+    return w->failed ? -1 : 0;
+}
+
+int col_writer_close(struct col_writer *w) {
+    int status;
+
+    flush_block(w);
+    status = w->failed || fclose(w->f) != 0 ? -1 : 0;
+    free(w);
+    return status;
+}
+
+int col_reader_open(struct col_reader *r, const char *path) {
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+
+    if (fd == -1) {
+        perror("Erro ao abrir o arquivo colunar");
+        return -1;
+    }
+    if (fstat(fd, &st) == -1 || (size_t) st.st_size < sizeof(r->hdr)) {
+        fprintf(stderr, "%s: arquivo colunar incompleto\n", path);
+        close(fd);
+        return -1;
+    }
+    r->size = (size_t) st.st_size;
+    r->map = mmap(NULL, r->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (r->map == MAP_FAILED) {
+        perror("Erro ao mapear o arquivo colunar");
+        return -1;
+    }
+    memcpy(&r->hdr, r->map, sizeof(r->hdr));
+    if (memcmp(r->hdr.magic, COL_MAGIC, sizeof(r->hdr.magic)) != 0 || r->hdr.version != COL_VERSION) {
+        fprintf(stderr, "%s: não é um arquivo colunar do meu_logger (versão %d)\n", path, COL_VERSION);
+        munmap((void *) r->map, r->size);
+        return -1;
+    }
+    r->next = sizeof(r->hdr);
+    return 0;
+}
+
+int col_reader_next(struct col_reader *r) {
+    size_t off;
+
+    if (r->next == r->size) {
+        return 0;
+    }
+    if (r->size - r->next < sizeof(r->block)) {
+        return -1;
+    }
+    memcpy(&r->block, r->map + r->next, sizeof(r->block));
+    if (r->block.columns != COL_COUNT || r->block.events == 0 || r->block.events > COL_BLOCK_EVENTS) {
+        return -1;
+    }
+    off = r->next + sizeof(r->block);
+    for (int c = 0; c < COL_COUNT; c++) {
+        if (r->block.stats[c].size > r->size - off) {
+            return -1;
+        }
+        r->columns[c] = r->map + off;
+        off += r->block.stats[c].size;
+    }
+    r->next = off;
+    return 1;
+}
+
+int col_reader_column(const struct col_reader *r, int col, uint64_t *out) {
+    const uint8_t *p = r->columns[col];
+    const uint8_t *end = p + r->block.stats[col].size;
+    uint32_t n = r->block.events;
+    uint64_t prev = 0;
+    uint64_t v;
+
+    if (col == COL_NR) {
+        int64_t dict[COL_DICT_MAX];
+        uint64_t len;
+
+        if (get_varint(&p, end, &len) == -1 || len > COL_DICT_MAX) {
+            return -1;
+        }
+        for (uint64_t d = 0; d < len; d++) {
+            if (get_varint(&p, end, &v) == -1) {
+                return -1;
+            }
+            dict[d] = unzigzag(v);
+        }
+        if ((size_t) (end - p) < n) {
+            return -1;
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            if (p[i] >= len) {
+                return -1;
+            }
+            out[i] = (uint64_t) dict[p[i]];
+        }
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (get_varint(&p, end, &v) == -1) {
+            return -1;
+        }
+        if (col == COL_DUR || col == COL_FLAGS) {
+            out[i] = v;
+        } else if (col == COL_RET) {
+            out[i] = (uint64_t) unzigzag(v);
+        } else {
+            prev += (uint64_t) unzigzag(v);
+            out[i] = prev;
+        }
+    }
+    return 0;
+}
+
+void col_reader_close(struct col_reader *r) {
+    munmap((void *) r->map, r->size);
+}
@@ -0,0 +1,88 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "trace_format.h"
+
+#ifndef COLUMNAR_H
+#define COLUMNAR_H
+
+// Formato colunar (./bin/decode -C), para análises que só precisam de alguns
+// campos. O arquivo começa com um trace_file_header (magic COL_MAGIC, mesmos
+// relógios e arquitetura do log binário) e segue com blocos de até
+// COL_BLOCK_EVENTS syscalls. Cada bloco é um col_block_header seguido das
+// colunas, na ordem de enum col_id, cada uma com os valores de todas as
+// syscalls do bloco:
+//  - ts e tid: o primeiro valor e depois as diferenças para o anterior, em
+//    varints zigzag (ver varint.h);
+//  - nr: dicionário do bloco (quantidade e números, em varints) e o índice de
+//    cada syscall no dicionário, um byte cada;
+//  - argumentos: diferença para o mesmo argumento da syscall anterior (zigzag);
+//  - ret: zigzag; dur e flags: varints.
+// O cabeçalho do bloco traz o tamanho e o mínimo/máximo de cada coluna: quem
+// lê uma coluna pula as outras sem decodificá-las, e um filtro por intervalo
+// (de tempo, por exemplo) pula blocos inteiros. Os payloads (-a, -y) não são
+// exportados e as repetições (-z) são expandidas.
+
+#define COL_MAGIC "SCLGCOL"   // 8 bytes, incluindo o '\0'
+#define COL_VERSION 1
+#define COL_BLOCK_EVENTS 4096
+
+enum col_id {
+    COL_TS,     // CLOCK_MONOTONIC na entrada
+    COL_TID,
+    COL_NR,
+    COL_RET,
+    COL_DUR,
+    COL_FLAGS,
+    COL_ARG1,   // ... até COL_ARG6
+    COL_COUNT = COL_ARG1 + 6
+};
+
+struct col_stats {
+    uint64_t min;     // Sem sinal, exceto em COL_NR e COL_RET (int64_t)
+    uint64_t max;
+    uint32_t size;    // Bytes da coluna no bloco
+    uint32_t reserved;
+};
+
+struct col_block_header {
+    uint32_t events;
+    uint32_t columns; // COL_COUNT
+    struct col_stats stats[COL_COUNT];
+};
+
+// Nome de cada coluna ("ts", "tid", "nr", "ret", "dur", "flags", "arg1"...)
+extern const char *const col_names[COL_COUNT];
+int col_by_name(const char *name);
+
+// --- Escrita (bloco a bloco, com memória fixa) ---
+
+struct col_writer;
+
+// Cria o arquivo com o cabeçalho hdr (o magic é trocado por COL_MAGIC)
+struct col_writer *col_writer_open(const char *path, const struct trace_file_header *hdr);
+// Acrescenta uma syscall; o bloco é gravado quando enche
+int col_writer_add(struct col_writer *w, const struct trace_record *rec);
+// Grava o último bloco e fecha o arquivo. Retorna -1 se alguma escrita falhou.
+int col_writer_close(struct col_writer *w);
+
+// --- Leitura (o arquivo inteiro é mapeado em memória) ---
+
+struct col_reader {
+    const uint8_t *map;
+    size_t size;
+    size_t next;                   // Posição do próximo bloco
+    struct trace_file_header hdr;
+    struct col_block_header block;        // Cabeçalho do bloco atual
+    const uint8_t *columns[COL_COUNT];    // Início de cada coluna do bloco atual
+};
+
+// Abre e valida o arquivo; retorna -1 (com a mensagem já impressa) em erro
+int col_reader_open(struct col_reader *r, const char *path);
+// Avança para o próximo bloco; retorna 1, 0 no fim ou -1 se o arquivo estiver corrompido
+int col_reader_next(struct col_reader *r);
+// Decodifica a coluna col do bloco atual em out (block.events valores).
+// COL_RET vem como int64_t convertido. Retorna -1 se a coluna estiver corrompida.
+int col_reader_column(const struct col_reader *r, int col, uint64_t *out);
+void col_reader_close(struct col_reader *r);
+
+#endif
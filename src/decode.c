@@ -0,0 +1,417 @@
+/**
+ * =====================================================================================
+ *
+ * Filename:  decode.c
+ *
+ * Description:  Decodificador do log binário (modo -b do meu_logger).
+ * Converte o syscall_log.bin para o mesmo layout de texto do syscall_log.txt,
+ * fora do caminho crítico do rastreamento. As repetições compactadas (-z) são
+ * expandidas de volta, uma syscall por bloco; com -z, ficam compactadas.
+ * Também exporta o log para o formato colunar (-C) e lê esse formato, inteiro
+ * ou só as colunas pedidas (-k), pulando os blocos fora do intervalo (-t).
+ * Com -J/-P, exporta a linha do tempo por thread (Chrome JSON / Perfetto).
+ *
+ * Team:  Sérgio, Joel, Gustavo e Vinícius
+ * * =====================================================================================
+ */
+#include "parser.h"
+#include "repeat.h"
+#include "columnar.h"
+#include "timeline.h"
+#include "trace_format.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Coluna "syscall" de -k: o número traduzido para o nome
+#define COL_SYSCALL_NAME COL_COUNT
+
+// Payload do registro atual (arredondado para posições inteiras de registro)
+static struct trace_record payload[1 + TRACE_PAYLOAD_MAX / sizeof(struct trace_record)];
+
+// Valores das colunas do bloco atual (leitura do formato colunar)
+static uint64_t values[COL_COUNT][COL_BLOCK_EVENTS];
+
+static struct trace_file_header hdr;
+static FILE *out = NULL;
+static struct col_writer *col_out = NULL; // -C: exporta em vez de escrever o texto
+static struct timeline_writer *timeline_out = NULL; // -J / -P
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Uso: %s [-z] <syscall_log.bin> [saida.txt]\n", prog);
+    fprintf(stderr, "     %s -C <saida.col> <syscall_log.bin>\n", prog);
+    fprintf(stderr, "     %s -J <saida.json> | -P <saida.perfetto-trace> <syscall_log.bin>\n", prog);
+    fprintf(stderr, "     %s [-k coluna,...] [-t INI:FIM] <arquivo.col> [saida.txt]\n", prog);
+    fprintf(stderr, "  -z  Mostra as repetições compactadas como no log de texto, sem expandi-las\n");
+    fprintf(stderr, "  -C  Exporta o log binário no formato colunar (blocos de %d syscalls)\n", COL_BLOCK_EVENTS);
+    fprintf(stderr, "  -J  Exporta a linha do tempo das threads no formato JSON do chrome://tracing\n");
+    fprintf(stderr, "  -P  Exporta a linha do tempo no formato do Perfetto (ui.perfetto.dev)\n");
+    fprintf(stderr, "  -k  Do arquivo colunar, imprime só as colunas pedidas, separadas por tabulação:\n");
+    fprintf(stderr, "      ts (ns desde o início), tid, nr, syscall, ret, dur, flags, arg1 ... arg6\n");
+    fprintf(stderr, "  -t  Só as syscalls iniciadas entre INI e FIM ms desde o início (ex: 1500:2000)\n");
+}
+
+/**
+ * @brief Entrega uma syscall à saída: o layout de texto, o arquivo colunar (-C)
+ * ou a linha do tempo (-J, -P).
+ */
+static void emit(const struct trace_record *rec, const void *data)
+{
+    if (timeline_out)
+    {
+        timeline_add(timeline_out, rec);
+        return;
+    }
+    if (col_out)
+    {
+        // O formato colunar não guarda payloads
+        struct trace_record r = *rec;
+        r.flags &= ~(uint32_t) TRACE_F_PAYLOAD;
+        r.payload = 0;
+        col_writer_add(col_out, &r);
+        return;
+    }
+    log_syscall_record(out, &hdr, rec, data);
+}
+
+/**
+ * @brief Lê os registros do log binário (já depois do cabeçalho) e os entrega a emit().
+ */
+static int read_binary(FILE *in, const char *path, int keep_repeats)
+{
+    struct trace_record rec;
+
+    // Leitura registro a registro (o stdio agrupa as leituras): um registro
+    // com TRACE_F_ARGS ou TRACE_F_REPEAT é seguido por um número variável de
+    // posições de payload
+    while (fread(&rec, sizeof(rec), 1, in) == 1)
+    {
+        if (!(rec.flags & TRACE_F_PAYLOAD))
+        {
+            emit(&rec, NULL);
+            continue;
+        }
+        if (rec.payload > TRACE_PAYLOAD_MAX ||
+            fread(payload, sizeof(payload[0]), TRACE_PAYLOAD_SLOTS(rec.payload), in) != TRACE_PAYLOAD_SLOTS(rec.payload))
+        {
+            fprintf(stderr, "%s: registro com payload corrompido ou incompleto\n", path);
+            return 1;
+        }
+        if (!(rec.flags & TRACE_F_REPEAT) || keep_repeats)
+        {
+            emit(&rec, payload);
+        }
+        else if (repeat_expand(&rec, payload, emit) == -1)
+        {
+            fprintf(stderr, "%s: repetição compactada corrompida\n", path);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Converte a lista de -k ("ts,syscall,dur") em colunas; retorna quantas, ou -1.
+ */
+static int parse_columns(char *list, int *cols)
+{
+    int n = 0;
+
+    for (char *name = strtok(list, ","); name; name = strtok(NULL, ","))
+    {
+        int c = strcmp(name, "syscall") == 0 ? COL_SYSCALL_NAME : col_by_name(name);
+        if (c == -1 || n == COL_COUNT + 1)
+        {
+            fprintf(stderr, "Coluna inválida: %s\n", name);
+            return -1;
+        }
+        cols[n++] = c;
+    }
+    return n;
+}
+
+/**
+ * @brief Lê o arquivo colunar: todas as colunas no layout de texto, ou só as de -k.
+ *
+ * Cada bloco tem o mínimo e o máximo de ts no cabeçalho: os blocos fora do
+ * intervalo de -t são pulados sem decodificar nada, e só as colunas pedidas
+ * são decodificadas nos outros.
+ */
+static int read_columnar(const char *path, char *columns, uint64_t from_ns, uint64_t to_ns)
+{
+    struct col_reader r;
+    int cols[COL_COUNT + 1];
+    int ncols = 0;
+    int need[COL_COUNT] = { 0 };
+    int status = 0;
+    int more;
+
+    if (columns && (ncols = parse_columns(columns, cols)) <= 0)
+        return 1;
+    if (col_reader_open(&r, path) == -1)
+        return 1;
+    hdr = r.hdr;
+    from_ns += hdr.start_monotonic_ns;
+    to_ns = to_ns == UINT64_MAX ? to_ns : to_ns + hdr.start_monotonic_ns;
+
+    if (!columns)
+    {
+        for (int c = 0; c < COL_COUNT; c++)
+            need[c] = 1;
+        fprintf(out, "--- Início do Log de Chamadas de Sistema ---\n\n");
+    }
+    else
+    {
+        for (int i = 0; i < ncols; i++)
+        {
+            need[cols[i] == COL_SYSCALL_NAME ? COL_NR : cols[i]] = 1;
+            fprintf(out, "%s%s", i ? "\t" : "", cols[i] == COL_SYSCALL_NAME ? "syscall" : col_names[cols[i]]);
+        }
+        fprintf(out, "\n");
+    }
+    need[COL_TS] = 1; // Para o filtro de tempo
+
+    while ((more = col_reader_next(&r)) == 1)
+    {
+        if (r.block.stats[COL_TS].max < from_ns || r.block.stats[COL_TS].min > to_ns)
+            continue;
+        for (int c = 0; c < COL_COUNT && more == 1; c++)
+        {
+            if (need[c] && col_reader_column(&r, c, values[c]) == -1)
+                more = -1;
+        }
+        if (more == -1)
+            break;
+
+        for (uint32_t i = 0; i < r.block.events; i++)
+        {
+            if (values[COL_TS][i] < from_ns || values[COL_TS][i] > to_ns)
+                continue;
+            if (!columns)
+            {
+                struct trace_record rec;
+                rec.ts_ns = values[COL_TS][i];
+                rec.tid = (uint32_t) values[COL_TID][i];
+                rec.nr = (int32_t) values[COL_NR][i];
+                rec.ret = (int64_t) values[COL_RET][i];
+                rec.dur_ns = values[COL_DUR][i];
+                rec.flags = (uint32_t) values[COL_FLAGS][i];
+                rec.payload = 0;
+                for (int a = 0; a < 6; a++)
+                    rec.args[a] = values[COL_ARG1 + a][i];
+                log_syscall_record(out, &hdr, &rec, NULL);
+                continue;
+            }
+            for (int k = 0; k < ncols; k++)
+            {
+                int c = cols[k];
+                if (k > 0)
+                    fputc('\t', out);
+                if (c == COL_SYSCALL_NAME)
+                    fputs(get_syscall_name_arch(hdr.arch, (long) (int64_t) values[COL_NR][i]), out);
+                else if (c == COL_TS)
+                    fprintf(out, "%llu", (unsigned long long) (values[c][i] - hdr.start_monotonic_ns));
+                else if (c == COL_NR || c == COL_RET)
+                    fprintf(out, "%lld", (long long) (int64_t) values[c][i]);
+                else
+                    fprintf(out, "%llu", (unsigned long long) values[c][i]);
+            }
+            fputc('\n', out);
+        }
+    }
+    if (more == -1)
+    {
+        fprintf(stderr, "%s: bloco corrompido ou incompleto\n", path);
+        status = 1;
+    }
+    if (!columns)
+        fprintf(out, "\n--- Fim do Log ---\n");
+    col_reader_close(&r);
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *path;
+    const char *col_path = NULL;
+    const char *timeline_path = NULL;
+    enum timeline_format timeline_format = TIMELINE_JSON;
+    char *columns = NULL;
+    uint64_t from_ns = 0;
+    uint64_t to_ns = UINT64_MAX;
+    int range = 0;
+    FILE *in;
+    int keep_repeats = 0;
+    int status = 0;
+    int opt;
+
+    out = stdout;
+    while ((opt = getopt(argc, argv, "zC:J:P:k:t:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'z':
+            keep_repeats = 1;
+            break;
+        case 'C':
+            col_path = optarg;
+            break;
+        case 'J':
+        case 'P':
+            timeline_path = optarg;
+            timeline_format = opt == 'J' ? TIMELINE_JSON : TIMELINE_PERFETTO;
+            break;
+        case 'k':
+            columns = optarg;
+            break;
+        case 't':
+        {
+            double from_ms, to_ms;
+            if (sscanf(optarg, "%lf:%lf", &from_ms, &to_ms) != 2 || from_ms < 0 || to_ms < from_ms)
+            {
+                fprintf(stderr, "Intervalo inválido: %s (use INI:FIM em ms, ex: 1500:2000)\n", optarg);
+                return 1;
+            }
+            from_ns = (uint64_t) (from_ms * 1e6);
+            to_ns = (uint64_t) (to_ms * 1e6);
+            range = 1;
+            break;
+        }
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (timeline_path && col_path)
+    {
+        fprintf(stderr, "Escolha uma exportação só: -C, -J ou -P.\n");
+        return 1;
+    }
+    if (argc - optind < 1 || argc - optind > 2 || ((col_path || timeline_path) && argc - optind != 1))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    path = argv[optind];
+
+    in = fopen(path, "rb");
+    if (!in)
+    {
+        perror("Erro ao abrir o log binário");
+        return 1;
+    }
+
+    if (fread(&hdr, sizeof(hdr), 1, in) != 1 ||
+        (memcmp(hdr.magic, TRACE_MAGIC, sizeof(hdr.magic)) != 0 && memcmp(hdr.magic, COL_MAGIC, sizeof(hdr.magic)) != 0))
+    {
+        fprintf(stderr, "%s: não é um log binário do meu_logger\n", path);
+        fclose(in);
+        return 1;
+    }
+    if (memcmp(hdr.magic, COL_MAGIC, sizeof(hdr.magic)) == 0)
+    {
+        // Arquivo colunar: lido pelo mapeamento, não pelo stdio
+        fclose(in);
+        if (col_path)
+        {
+            fprintf(stderr, "%s: o arquivo já está no formato colunar\n", path);
+            return 1;
+        }
+        if (timeline_path)
+        {
+            fprintf(stderr, "%s: a linha do tempo é exportada do log binário, não do colunar\n", path);
+            return 1;
+        }
+        if (argc - optind == 2 && !(out = fopen(argv[optind + 1], "w")))
+        {
+            perror("Erro ao abrir o arquivo de saída");
+            return 1;
+        }
+        status = read_columnar(path, columns, from_ns, to_ns);
+        if (out != stdout)
+            fclose(out);
+        return status;
+    }
+    if (columns || range)
+    {
+        fprintf(stderr, "As opções -k e -t valem só para arquivos colunares (gerados com -C).\n");
+        fclose(in);
+        return 1;
+    }
+    // As versões 2 e 3 são a 4 sem registros com TRACE_F_ARGS ou TRACE_F_REPEAT
+    if (hdr.version < 2 || hdr.version > TRACE_VERSION)
+    {
+        fprintf(stderr, "%s: versão %u do formato não suportada\n", path, hdr.version);
+        fclose(in);
+        return 1;
+    }
+    // Os nomes são resolvidos aqui, pela etiqueta de arquitetura do cabeçalho:
+    // um log de aarch64 pode ser lido numa máquina x86_64 e vice-versa
+    if (hdr.arch != TRACE_ARCH_X86_64 && hdr.arch != TRACE_ARCH_AARCH64)
+    {
+        fprintf(stderr, "%s: arquitetura %u desconhecida\n", path, hdr.arch);
+        fclose(in);
+        return 1;
+    }
+
+    if (timeline_path)
+    {
+        timeline_out = timeline_open(timeline_path, &hdr, timeline_format);
+        if (!timeline_out)
+        {
+            perror("Erro ao criar o arquivo da linha do tempo");
+            fclose(in);
+            return 1;
+        }
+        status = read_binary(in, path, 0);
+        if (timeline_close(timeline_out) == -1)
+        {
+            perror("Erro ao gravar o arquivo da linha do tempo");
+            status = 1;
+        }
+        fclose(in);
+        return status;
+    }
+    if (col_path)
+    {
+        col_out = col_writer_open(col_path, &hdr);
+        if (!col_out)
+        {
+            perror("Erro ao criar o arquivo colunar");
+            fclose(in);
+            return 1;
+        }
+        status = read_binary(in, path, 0);
+        if (col_writer_close(col_out) == -1)
+        {
+            perror("Erro ao gravar o arquivo colunar");
+            status = 1;
+        }
+        fclose(in);
+        return status;
+    }
+
+    if (argc - optind == 2)
+    {
+        out = fopen(argv[optind + 1], "w");
+        if (!out)
+        {
+            perror("Erro ao abrir o arquivo de saída");
+            fclose(in);
+            return 1;
+        }
+    }
+
+    fprintf(out, "--- Início do Log de Chamadas de Sistema ---\n\n");
+    status = read_binary(in, path, keep_repeats);
+    fprintf(out, "\n--- Fim do Log ---\n");
+
+    fclose(in);
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+    return status;
+}
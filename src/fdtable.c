@@ -0,0 +1,457 @@
+#define _GNU_SOURCE // process_vm_readv()
+#include "fdtable.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#ifndef CLOSE_RANGE_CLOEXEC
+#define CLOSE_RANGE_CLOEXEC (1U << 2)
+#endif
+
+struct fd_entry {
+    char *desc;          // NULL: descritor fechado
+    uint32_t len;
+    uint8_t cloexec;
+    uint8_t missing;     // Já procurado em /proc, sem sucesso
+};
+
+struct fd_table {
+    int refs;            // Threads que usam a tabela (as de um mesmo processo)
+    int size;            // Posições alocadas em fds (potência de 2)
+    struct fd_entry *fds;
+};
+
+static struct fd_table *table_new(void) {
+    struct fd_table *ft = calloc(1, sizeof(*ft));
+
+    if (!ft) {
+        perror("calloc");
+        exit(1);
+    }
+    ft->refs = 1;
+    return ft;
+}
+
+static void fd_close(struct fd_table *ft, int64_t fd) {
+    if (fd >= 0 && fd < ft->size) {
+        free(ft->fds[fd].desc);
+        ft->fds[fd].desc = NULL;
+        ft->fds[fd].missing = 0;
+    }
+}
+
+/**
+ * @brief Aumenta a tabela até caber fd; retorna -1 se fd passa do limite ou sem memória.
+ */
+static int fd_grow(struct fd_table *ft, int64_t fd) {
+    int size = ft->size ? ft->size : 64;
+    struct fd_entry *fds;
+
+    if (fd < 0 || fd >= FDTABLE_MAX_FD) {
+        return -1;
+    }
+    if (fd < ft->size) {
+        return 0;
+    }
+    while (size <= fd) {
+        size *= 2;
+    }
+    fds = realloc(ft->fds, (size_t) size * sizeof(*fds));
+    if (!fds) {
+        return -1;
+    }
+    memset(fds + ft->size, 0, (size_t) (size - ft->size) * sizeof(*fds));
+    ft->fds = fds;
+    ft->size = size;
+    return 0;
+}
+
+static void fd_store(struct fd_table *ft, int64_t fd, const char *desc, size_t len, int cloexec) {
+    char *copy;
+
+    if (fd_grow(ft, fd) == -1) {
+        return;
+    }
+    copy = malloc(len + 1);
+    if (!copy) {
+        return;
+    }
+    memcpy(copy, desc, len);
+    copy[len] = '\0';
+    fd_close(ft, fd);
+    ft->fds[fd].desc = copy;
+    ft->fds[fd].len = (uint32_t) len;
+    ft->fds[fd].cloexec = (uint8_t) (cloexec != 0);
+}
+
+/**
+ * @brief Lê o descritor fd da thread tid em /proc: destino do link e FD_CLOEXEC.
+ * * @param cloexec -1 para ler o bit em /proc/<tid>/fdinfo/<fd>.
+ */
+static int fd_from_proc(struct fd_table *ft, pid_t tid, int64_t fd, int cloexec) {
+    char path[64];
+    char target[4096];
+    ssize_t len;
+
+    if (fd >= 0 && fd < ft->size) {
+        ft->fds[fd].missing = 0; // Descritor novo: a busca anterior não vale mais
+    }
+    snprintf(path, sizeof(path), "/proc/%d/fd/%lld", (int) tid, (long long) fd);
+    len = readlink(path, target, sizeof(target));
+    if (len <= 0) {
+        return -1;
+    }
+    if (cloexec < 0) {
+        char line[128];
+        FILE *f;
+
+        cloexec = 0;
+        snprintf(path, sizeof(path), "/proc/%d/fdinfo/%lld", (int) tid, (long long) fd);
+        f = fopen(path, "r");
+        if (f) {
+            while (fgets(line, sizeof(line), f)) {
+                if (strncmp(line, "flags:", 6) == 0) {
+                    cloexec = (strtoul(line + 6, NULL, 8) & O_CLOEXEC) != 0;
+                    break;
+                }
+            }
+            fclose(f);
+        }
+    }
+    fd_store(ft, fd, target, (size_t) len, cloexec);
+    return 0;
+}
+
+static struct fd_table *table_from_proc(pid_t pid) {
+    struct fd_table *ft = table_new();
+    char path[64];
+    struct dirent *de;
+    DIR *dir;
+
+    snprintf(path, sizeof(path), "/proc/%d/fd", (int) pid);
+    dir = opendir(path);
+    if (!dir) {
+        return ft;
+    }
+    while ((de = readdir(dir)) != NULL) {
+        if (de->d_name[0] != '.') {
+            fd_from_proc(ft, pid, atoll(de->d_name), -1);
+        }
+    }
+    closedir(dir);
+    return ft;
+}
+
+/**
+ * @brief Tabela da thread; criada a partir de /proc se a thread ainda não tem
+ *        uma (uma thread nova pode parar antes de o pai reportar o clone).
+ */
+static struct fd_table *table_of(struct tracee *t) {
+    if (!t->fds) {
+        t->fds = table_from_proc(tracee_tgid(t));
+    }
+    return t->fds;
+}
+
+void fdtable_seed_tracees(pid_t pid) {
+    struct fd_table *ft = table_from_proc(pid);
+    int n = tracee_count();
+    pid_t *tids = malloc(sizeof(pid_t) * (n > 0 ? n : 1));
+
+    // Todas as threads anexadas recebem a mesma tabela: uma que ficasse de
+    // fora montaria uma cópia própria em table_of() e deixaria de ver os
+    // close/dup das outras
+    if (tids) {
+        n = tracee_tids(tids, n);
+        for (int i = 0; i < n; i++) {
+            struct tracee *t = tracee_find(tids[i]);
+            fdtable_put(t->fds);
+            t->fds = ft;
+            ft->refs++;
+        }
+        free(tids);
+    }
+    fdtable_put(ft);
+}
+
+void fdtable_put(struct fd_table *ft) {
+    if (!ft || --ft->refs > 0) {
+        return;
+    }
+    for (int fd = 0; fd < ft->size; fd++) {
+        free(ft->fds[fd].desc);
+    }
+    free(ft->fds);
+    free(ft);
+}
+
+/**
+ * @brief Copia para to os descritores abertos em from; overwrite: 0 mantém os que to já tem.
+ */
+static void table_merge(struct fd_table *to, const struct fd_table *from, int overwrite) {
+    for (int fd = 0; fd < from->size; fd++) {
+        if (from->fds[fd].desc && (overwrite || fd >= to->size || !to->fds[fd].desc)) {
+            fd_store(to, fd, from->fds[fd].desc, from->fds[fd].len, from->fds[fd].cloexec);
+        }
+    }
+}
+
+void fdtable_inherit(struct tracee *parent, struct tracee *child, int same_process) {
+    struct fd_table *from = table_of(parent);
+
+    // O filho pode ter parado (e aberto descritores) antes de o pai reportar
+    // o clone/fork; o que ele já tem não se perde
+    if (same_process) {
+        if (child->fds != from) {
+            if (child->fds) {
+                table_merge(from, child->fds, 1);
+                fdtable_put(child->fds);
+            }
+            child->fds = from;
+            from->refs++;
+        }
+        return;
+    }
+    if (!child->fds || child->fds == from) {
+        fdtable_put(child->fds);
+        child->fds = table_new();
+    }
+    table_merge(child->fds, from, 0);
+}
+
+void fdtable_exec(struct tracee *t) {
+    struct fd_table *ft = table_of(t);
+
+    for (int fd = 0; fd < ft->size; fd++) {
+        if (ft->fds[fd].cloexec) {
+            fd_close(ft, fd);
+        }
+    }
+}
+
+const char *fdtable_describe(struct tracee *t, int64_t fd, uint32_t *len) {
+    struct fd_table *ft;
+
+    if (fd < 0 || fd >= FDTABLE_MAX_FD) {
+        return NULL;
+    }
+    ft = table_of(t);
+    if (fd < ft->size && ft->fds[fd].missing) {
+        return NULL;
+    }
+    // Descritor que o logger não viu nascer (herdado antes do -p, recebido por
+    // SCM_RIGHTS, criado fora do filtro -f...): uma consulta a /proc, guardada.
+    // Um descritor que também não está lá (read(fd) com EBADF...) fica marcado
+    // até o próximo open/dup/close nele, para não ser procurado a cada evento.
+    if ((fd >= ft->size || !ft->fds[fd].desc) && fd_from_proc(ft, t->tid, fd, -1) == -1) {
+        if (fd_grow(ft, fd) == 0) {
+            ft->fds[fd].missing = 1;
+        }
+        return NULL;
+    }
+    *len = ft->fds[fd].len;
+    return ft->fds[fd].desc;
+}
+
+/**
+ * @brief Duplica a descrição de from em to (dup, accept...).
+ */
+static void fd_copy(struct tracee *t, int64_t from, int64_t to, int cloexec) {
+    uint32_t len;
+    const char *desc = fdtable_describe(t, from, &len);
+
+    if (desc) {
+        // A cópia é feita antes: fd_store() pode realocar a tabela
+        char *copy = strndup(desc, len);
+        if (copy) {
+            fd_store(t->fds, to, copy, len, cloexec);
+            free(copy);
+        }
+    } else {
+        fd_from_proc(t->fds, t->tid, to, cloexec);
+    }
+}
+
+static void fd_socket(struct fd_table *ft, int64_t fd, uint64_t domain, uint64_t type) {
+    char desc[64];
+    const char *d, *s;
+
+    switch (domain) {
+    case AF_UNIX: d = "unix"; break;
+    case AF_INET: d = "inet"; break;
+    case AF_INET6: d = "inet6"; break;
+    case AF_NETLINK: d = "netlink"; break;
+    case AF_PACKET: d = "packet"; break;
+    default: d = NULL; break;
+    }
+    switch (type & 0xf) {
+    case SOCK_STREAM: s = "stream"; break;
+    case SOCK_DGRAM: s = "dgram"; break;
+    case SOCK_RAW: s = "raw"; break;
+    case SOCK_SEQPACKET: s = "seqpacket"; break;
+    default: s = NULL; break;
+    }
+    if (d && s) {
+        snprintf(desc, sizeof(desc), "socket:%s/%s", d, s);
+    } else {
+        snprintf(desc, sizeof(desc), "socket:%llu/%llu", (unsigned long long) domain,
+                 (unsigned long long) (type & 0xf));
+    }
+    fd_store(ft, fd, desc, strlen(desc), (type & SOCK_CLOEXEC) != 0);
+}
+
+/**
+ * @brief Lê o par de descritores que pipe()/socketpair() gravou na memória da thread.
+ */
+static int read_pair(pid_t tid, uint64_t addr, int pair[2]) {
+    struct iovec local = { pair, 2 * sizeof(int) };
+    struct iovec remote = { (void *) (uintptr_t) addr, 2 * sizeof(int) };
+
+    return process_vm_readv(tid, &local, 1, &remote, 1, 0) == (ssize_t) (2 * sizeof(int)) ? 0 : -1;
+}
+
+int fdtable_exit(struct tracee *t, long nr, const uint64_t *args, int64_t ret) {
+    struct fd_table *ft = table_of(t);
+    int pair[2];
+
+    // close() libera o descritor mesmo quando falha, exceto com EBADF
+    if (nr == SYS_close) {
+        if (ret != -EBADF) {
+            fd_close(ft, (int64_t) (int) args[0]);
+        }
+        return 0;
+    }
+    if (ret < 0) {
+        return 0;
+    }
+
+    switch (nr) {
+#ifdef SYS_open
+    case SYS_open:
+        fd_from_proc(ft, t->tid, ret, (args[1] & O_CLOEXEC) != 0);
+        return 1;
+#endif
+#ifdef SYS_creat
+    case SYS_creat:
+        fd_from_proc(ft, t->tid, ret, 0);
+        return 1;
+#endif
+    case SYS_openat:
+        fd_from_proc(ft, t->tid, ret, (args[2] & O_CLOEXEC) != 0);
+        return 1;
+
+    case SYS_socket:
+        fd_socket(ft, ret, args[0], args[1]);
+        return 1;
+    case SYS_socketpair:
+        if (read_pair(t->tid, args[3], pair) == 0) {
+            fd_socket(ft, pair[0], args[0], args[1]);
+            fd_socket(ft, pair[1], args[0], args[1]);
+        }
+        return 0;
+    case SYS_accept:
+        fd_copy(t, (int) args[0], ret, 0);
+        return 1;
+    case SYS_accept4:
+        fd_copy(t, (int) args[0], ret, (args[3] & SOCK_CLOEXEC) != 0);
+        return 1;
+
+#ifdef SYS_pipe
+    case SYS_pipe:
+#endif
+    case SYS_pipe2:
+        // O link em /proc traz o inode ("pipe:[1234]"), que liga as duas pontas
+        if (read_pair(t->tid, args[0], pair) == 0) {
+            int cloexec = nr == SYS_pipe2 && (args[1] & O_CLOEXEC);
+            fd_from_proc(ft, t->tid, pair[0], cloexec);
+            fd_from_proc(ft, t->tid, pair[1], cloexec);
+        }
+        return 0;
+
+    case SYS_dup:
+        fd_copy(t, (int) args[0], ret, 0);
+        return 1;
+#ifdef SYS_dup2
+    case SYS_dup2:
+        if ((int) args[0] != ret) {
+            fd_copy(t, (int) args[0], ret, 0);
+        }
+        return 1;
+#endif
+    case SYS_dup3:
+        fd_copy(t, (int) args[0], ret, (args[2] & O_CLOEXEC) != 0);
+        return 1;
+
+    case SYS_fcntl:
+        if ((int) args[1] == F_DUPFD || (int) args[1] == F_DUPFD_CLOEXEC) {
+            fd_copy(t, (int) args[0], ret, (int) args[1] == F_DUPFD_CLOEXEC);
+            return 1;
+        }
+        if ((int) args[1] == F_SETFD && (int) args[0] >= 0 && (int) args[0] < ft->size) {
+            ft->fds[(int) args[0]].cloexec = (args[2] & FD_CLOEXEC) != 0;
+        }
+        return 0;
+
+#ifdef SYS_close_range
+    case SYS_close_range:
+        for (uint64_t fd = args[0]; fd <= args[1] && fd < (uint64_t) ft->size; fd++) {
+            if (args[2] & CLOSE_RANGE_CLOEXEC) {
+                ft->fds[fd].cloexec = 1;
+            } else {
+                fd_close(ft, (int64_t) fd);
+            }
+        }
+        return 0;
+#endif
+
+    // Outras syscalls que criam descritores: o destino do link em /proc diz o
+    // tipo ("anon_inode:[eventfd]"...) e o fdinfo, o FD_CLOEXEC
+#ifdef SYS_openat2
+    case SYS_openat2:
+#endif
+#ifdef SYS_eventfd
+    case SYS_eventfd:
+#endif
+#ifdef SYS_epoll_create
+    case SYS_epoll_create:
+#endif
+#ifdef SYS_signalfd
+    case SYS_signalfd:
+#endif
+#ifdef SYS_inotify_init
+    case SYS_inotify_init:
+#endif
+#ifdef SYS_pidfd_open
+    case SYS_pidfd_open:
+#endif
+#ifdef SYS_pidfd_getfd
+    case SYS_pidfd_getfd:
+#endif
+#ifdef SYS_memfd_secret
+    case SYS_memfd_secret:
+#endif
+    case SYS_open_by_handle_at:
+    case SYS_eventfd2:
+    case SYS_epoll_create1:
+    case SYS_timerfd_create:
+    case SYS_signalfd4:
+    case SYS_inotify_init1:
+    case SYS_fanotify_init:
+    case SYS_memfd_create:
+    case SYS_userfaultfd:
+    case SYS_perf_event_open:
+    case SYS_io_uring_setup:
+    case SYS_mq_open:
+        fd_from_proc(ft, t->tid, ret, -1);
+        return 1;
+    default:
+        return 0;
+    }
+}
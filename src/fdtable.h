@@ -0,0 +1,43 @@
+#include <stdint.h>
+#include <sys/types.h>
+#include "tracee_table.h"
+
+#ifndef FDTABLE_H
+#define FDTABLE_H
+
+// Tabela de descritores de cada processo rastreado (-y): o que cada fd é
+// (caminho, socket, pipe...), para anotar os argumentos de read(3, ...) e
+// companhia em O(1). É montada a partir dos resultados de open, socket,
+// accept, pipe, dup, fcntl e close vistos no loop principal; /proc/<pid>/fd
+// só é lido uma vez no início e para descritores que o logger não viu nascer.
+// As threads de um processo compartilham a tabela; um fork recebe uma cópia
+// e o execve descarta os descritores com FD_CLOEXEC.
+
+// Maior descritor acompanhado (a tabela é densa, indexada pelo fd)
+#define FDTABLE_MAX_FD (1 << 20)
+
+struct fd_table;
+
+// Lê /proc/<pid>/fd e entrega a tabela às threads já rastreadas do processo
+// (depois de iniciar o comando ou de anexar com -p)
+void fdtable_seed_tracees(pid_t pid);
+
+// Thread ou processo novo (PTRACE_EVENT_CLONE/FORK/VFORK): same_process
+// compartilha a tabela do pai; senão, o filho recebe uma cópia
+void fdtable_inherit(struct tracee *parent, struct tracee *child, int same_process);
+
+// Solta a referência da thread (a tabela é liberada com a última)
+void fdtable_put(struct fd_table *ft);
+
+// execve concluído: fecha os descritores com FD_CLOEXEC
+void fdtable_exec(struct tracee *t);
+
+// Na saída de uma syscall, aplica seu efeito sobre os descritores.
+// Retorna 1 se o retorno é um descritor novo (open, socket, dup...).
+int fdtable_exit(struct tracee *t, long nr, const uint64_t *args, int64_t ret);
+
+// O que o descritor fd da thread t é ("/etc/hosts", "socket:inet/stream"...),
+// ou NULL se não estiver aberto. *len recebe o tamanho.
+const char *fdtable_describe(struct tracee *t, int64_t fd, uint32_t *len);
+
+#endif
@@ -0,0 +1,272 @@
+#include "filter.h"
+#include "parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FILTER_WORDS ((SYSCALL_NR_MAX + 63) / 64)
+
+// Operações do programa de condições sobre o retorno
+enum filter_op {
+    OP_LT, OP_LE, OP_GT, OP_GE, OP_EQ, OP_NE,
+    OP_FAILED,     // -4095 <= ret <= -1 (errno)
+    OP_SUCCEEDED
+};
+
+struct filter_predicate {
+    enum filter_op op;
+    int64_t value;
+};
+
+static int active = 0;
+
+// Mapa de bits das syscalls selecionadas (tudo marcado se não houver trace=)
+static uint64_t syscalls[FILTER_WORDS];
+static int trace_given = 0;
+static int accept_unknown = 1;   // Números fora das tabelas (>= SYSCALL_NR_MAX)
+
+static struct filter_predicate program[FILTER_MAX_PREDICATES];
+static int program_len = 0;
+
+static pid_t pids[FILTER_MAX_IDS];
+static int pid_count = 0;
+static pid_t tids[FILTER_MAX_IDS];
+static int tid_count = 0;
+
+static const struct {
+    const char *name;
+    unsigned int mask;
+} class_names[] = {
+    { "file", SYSCALL_CLASS_FILE },
+    { "desc", SYSCALL_CLASS_DESC },
+    { "network", SYSCALL_CLASS_NETWORK },
+    { "net", SYSCALL_CLASS_NETWORK },
+    { "process", SYSCALL_CLASS_PROCESS },
+    { "memory", SYSCALL_CLASS_MEMORY },
+    { "signal", SYSCALL_CLASS_SIGNAL },
+    { "ipc", SYSCALL_CLASS_IPC },
+};
+
+static void set_bit(long nr, int on) {
+    if (on) {
+        syscalls[nr / 64] |= 1ULL << (nr % 64);
+    } else {
+        syscalls[nr / 64] &= ~(1ULL << (nr % 64));
+    }
+}
+
+/**
+ * @brief Aplica um item de trace= (nome, número ou %classe) ao mapa de bits.
+ */
+static int apply_trace_item(const char *item, int on) {
+    char *end;
+    long nr;
+
+    if (item[0] == '%') {
+        for (size_t i = 0; i < sizeof(class_names) / sizeof(class_names[0]); i++) {
+            if (strcmp(item + 1, class_names[i].name) == 0) {
+                for (long n = 0; n < SYSCALL_NR_MAX; n++) {
+                    if (get_syscall_classes(n) & class_names[i].mask) {
+                        set_bit(n, on);
+                    }
+                }
+                return 0;
+            }
+        }
+        fprintf(stderr, "Classe de syscalls desconhecida: %s\n", item);
+        return -1;
+    }
+
+    nr = strtol(item, &end, 10);
+    if (*end != '\0') {
+        nr = get_syscall_number(item);
+    }
+    if (nr < 0 || nr >= SYSCALL_NR_MAX) {
+        fprintf(stderr, "Syscall desconhecida no filtro: %s\n", item);
+        return -1;
+    }
+    set_bit(nr, on);
+    return 0;
+}
+
+static int parse_trace(const char *list) {
+    char *copy = strdup(list);
+    char *rest = copy;
+    char *item;
+    int ret = 0;
+
+    if (!copy) {
+        return -1;
+    }
+
+    // Só exclusões ("!futex,!%signal"): parte de todas as syscalls
+    if (list[0] == '!') {
+        memset(syscalls, 0xff, sizeof(syscalls));
+    } else {
+        memset(syscalls, 0, sizeof(syscalls));
+        accept_unknown = 0;
+    }
+    trace_given = 1;
+
+    while (ret == 0 && (item = strsep(&rest, ",")) != NULL) {
+        if (*item == '\0') {
+            continue;
+        }
+        if (*item == '!') {
+            ret = apply_trace_item(item + 1, 0);
+        } else {
+            ret = apply_trace_item(item, 1);
+        }
+    }
+    free(copy);
+    return ret;
+}
+
+static int parse_ids(const char *list, pid_t *ids, int *count) {
+    const char *p = list;
+
+    while (*p) {
+        char *end;
+        long id = strtol(p, &end, 10);
+        if (end == p || id <= 0 || (*end != ',' && *end != '\0')) {
+            fprintf(stderr, "Lista de PIDs inválida: %s\n", list);
+            return -1;
+        }
+        if (*count == FILTER_MAX_IDS) {
+            fprintf(stderr, "PIDs demais no filtro (máximo %d)\n", FILTER_MAX_IDS);
+            return -1;
+        }
+        ids[(*count)++] = (pid_t) id;
+        p = *end ? end + 1 : end;
+    }
+    return 0;
+}
+
+static int add_predicate(enum filter_op op, int64_t value) {
+    if (program_len == FILTER_MAX_PREDICATES) {
+        fprintf(stderr, "Condições demais no filtro (máximo %d)\n", FILTER_MAX_PREDICATES);
+        return -1;
+    }
+    program[program_len].op = op;
+    program[program_len].value = value;
+    program_len++;
+    return 0;
+}
+
+static int parse_ret(const char *cond) {
+    // Operadores de dois caracteres primeiro, para que "<=" não vire "<"
+    static const struct {
+        const char *text;
+        enum filter_op op;
+    } ops[] = {
+        { "<=", OP_LE }, { ">=", OP_GE }, { "==", OP_EQ }, { "!=", OP_NE },
+        { "<", OP_LT }, { ">", OP_GT }, { "=", OP_EQ },
+    };
+
+    for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+        size_t len = strlen(ops[i].text);
+        if (strncmp(cond, ops[i].text, len) == 0) {
+            char *end;
+            long long value = strtoll(cond + len, &end, 0);
+            if (end == cond + len || *end != '\0') {
+                break;
+            }
+            return add_predicate(ops[i].op, value);
+        }
+    }
+    fprintf(stderr, "Condição sobre o retorno inválida: ret%s\n", cond);
+    return -1;
+}
+
+int filter_parse(const char *expr) {
+    int ret;
+
+    if (strncmp(expr, "trace=", 6) == 0) {
+        ret = parse_trace(expr + 6);
+    } else if (strcmp(expr, "status=failed") == 0) {
+        ret = add_predicate(OP_FAILED, 0);
+    } else if (strcmp(expr, "status=successful") == 0) {
+        ret = add_predicate(OP_SUCCEEDED, 0);
+    } else if (strncmp(expr, "ret", 3) == 0) {
+        ret = parse_ret(expr + 3);
+    } else if (strncmp(expr, "pid=", 4) == 0) {
+        ret = parse_ids(expr + 4, pids, &pid_count);
+    } else if (strncmp(expr, "tid=", 4) == 0) {
+        ret = parse_ids(expr + 4, tids, &tid_count);
+    } else {
+        fprintf(stderr, "Expressão de filtro inválida: %s\n", expr);
+        ret = -1;
+    }
+    if (ret == 0) {
+        active = 1;
+    }
+    return ret;
+}
+
+int filter_active(void) {
+    return active;
+}
+
+int filter_needs_tgid(void) {
+    return pid_count > 0;
+}
+
+static int in_list(pid_t id, const pid_t *ids, int count) {
+    for (int i = 0; i < count; i++) {
+        if (ids[i] == id) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int filter_entry(long nr, pid_t tid, pid_t tgid) {
+    if (trace_given) {
+        if (nr < 0 || nr >= SYSCALL_NR_MAX) {
+            if (!accept_unknown) {
+                return 0;
+            }
+        } else if (!(syscalls[nr / 64] & (1ULL << (nr % 64)))) {
+            return 0;
+        }
+    }
+    if (tid_count > 0 && !in_list(tid, tids, tid_count)) {
+        return 0;
+    }
+    if (pid_count > 0 && !in_list(tgid, pids, pid_count)) {
+        return 0;
+    }
+    return 1;
+}
+
+int filter_exit(const struct trace_record *rec) {
+    int64_t ret = rec->ret;
+
+    if (program_len == 0) {
+        return 1;
+    }
+    // Sem a parada de saída (exit_group...), não há retorno para testar
+    if (!(rec->flags & TRACE_F_EXIT)) {
+        return 0;
+    }
+    for (int i = 0; i < program_len; i++) {
+        int64_t v = program[i].value;
+        int ok;
+
+        switch (program[i].op) {
+        case OP_LT: ok = ret < v; break;
+        case OP_LE: ok = ret <= v; break;
+        case OP_GT: ok = ret > v; break;
+        case OP_GE: ok = ret >= v; break;
+        case OP_EQ: ok = ret == v; break;
+        case OP_NE: ok = ret != v; break;
+        case OP_FAILED: ok = ret < 0 && ret >= -4095; break;
+        case OP_SUCCEEDED: ok = ret >= 0 || ret < -4095; break;
+        default: ok = 1; break;
+        }
+        if (!ok) {
+            return 0;
+        }
+    }
+    return 1;
+}
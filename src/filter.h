@@ -0,0 +1,37 @@
+#include <stdint.h>
+#include <sys/types.h>
+#include "trace_format.h"
+
+#ifndef FILTER_H
+#define FILTER_H
+
+// Expressões de filtro (-e), compiladas uma vez na inicialização:
+//   trace=LISTA    syscalls (nomes, números ou classes %file, %desc, %network,
+//                  %process, %memory, %signal, %ipc); "!item" tira da seleção.
+//                  Se a lista só tem exclusões, parte de todas as syscalls.
+//   status=failed|successful
+//   ret<N, ret<=N, ret>N, ret>=N, ret==N, ret!=N
+//   pid=LISTA / tid=LISTA   processos (tgid) ou threads a registrar
+// Várias opções -e se combinam com "e" (um trace= repetido substitui o anterior). O conjunto de syscalls vira um mapa
+// de bits indexado pelo número; as condições sobre o retorno viram um
+// pequeno programa avaliado na saída da syscall.
+#define FILTER_MAX_PREDICATES 16
+#define FILTER_MAX_IDS 64
+
+// Compila uma expressão. Retorna 0 ou -1 (com a mensagem de erro já impressa).
+int filter_parse(const char *expr);
+
+// 1 se alguma expressão foi dada
+int filter_active(void);
+
+// 1 se a syscall nr feita por tid (do processo tgid) deve ser registrada.
+// Avaliada na entrada. tgid só é usado com pid=; passe 0 se não for conhecido.
+int filter_entry(long nr, pid_t tid, pid_t tgid);
+
+// 1 se os filtros de pid=LISTA precisam do tgid
+int filter_needs_tgid(void);
+
+// 1 se o registro completo passa nas condições sobre o retorno
+int filter_exit(const struct trace_record *rec);
+
+#endif
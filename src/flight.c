@@ -0,0 +1,172 @@
+#include "flight.h"
+#include "output.h"
+#include "parser.h"
+#include "seccomp_filter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+
+#define FLIGHT_TRIGGER_INTERVAL_NS 1000000000ULL // Intervalo mínimo entre gatilhos de syscall
+
+static struct trace_record *slots = NULL;
+static uint32_t capacity = 0;
+static uint64_t total = 0;          // Registros recebidos desde o início
+
+static unsigned char trigger_call[SYSCALL_NR_MAX];
+static unsigned char trigger_error[SYSCALL_NR_MAX];
+static uint64_t last_trigger_ns = 0;
+static int dumps = 0;
+// Tirado no início da gravação: os instantes dos registros são relativos a ele
+static struct trace_file_header header;
+
+int flight_init(uint32_t n) {
+    slots = calloc(n, sizeof(*slots));
+    if (!slots) {
+        return -1;
+    }
+    capacity = n;
+    trace_header_init(&header);
+    return 0;
+}
+
+int flight_enabled(void) {
+    return capacity > 0;
+}
+
+/**
+ * @brief Marca em table as syscalls da lista.
+ */
+static int parse_triggers(const char *lista, unsigned char *table) {
+    int numeros[SECCOMP_FILTER_MAX];
+    int n = seccomp_filter_parse(lista, numeros, SECCOMP_FILTER_MAX);
+
+    for (int i = 0; i < n; i++) {
+        table[numeros[i]] = 1;
+    }
+    return n;
+}
+
+int flight_trigger_calls(const char *lista) {
+    return parse_triggers(lista, trigger_call);
+}
+
+int flight_trigger_errors(const char *lista) {
+    if (strcmp(lista, "todas") == 0) {
+        memset(trigger_error, 1, sizeof(trigger_error));
+        return SYSCALL_NR_MAX;
+    }
+    return parse_triggers(lista, trigger_error);
+}
+
+void flight_record(const struct trace_record *rec) {
+    char reason[96];
+    int nr = rec->nr;
+
+    slots[total % capacity] = *rec;
+    total++;
+
+    if (nr < 0 || nr >= SYSCALL_NR_MAX) {
+        return;
+    }
+    if (trigger_call[nr]) {
+        snprintf(reason, sizeof(reason), "%s chamada pelo tid %u", get_syscall_name(nr), rec->tid);
+    } else if (trigger_error[nr] && (rec->flags & TRACE_F_EXIT) && rec->ret < 0 && rec->ret >= -4095) {
+        snprintf(reason, sizeof(reason), "%s retornou %lld no tid %u", get_syscall_name(nr),
+                 (long long) rec->ret, rec->tid);
+    } else {
+        return;
+    }
+
+    if (dumps > 0 && monotonic_ns() - last_trigger_ns < FLIGHT_TRIGGER_INTERVAL_NS) {
+        return;
+    }
+    flight_dump(reason);
+    last_trigger_ns = monotonic_ns();
+}
+
+/**
+ * @brief Lê uma máscara de sinais (SigCgt, SigIgn...) de /proc/<tid>/status.
+ */
+static unsigned long long signal_mask(pid_t tid, const char *field) {
+    char path[64];
+    char line[128];
+    unsigned long long mask = 0;
+    size_t len = strlen(field);
+    FILE *f;
+
+    snprintf(path, sizeof(path), "/proc/%d/status", (int) tid);
+    f = fopen(path, "r");
+    if (!f) {
+        return 0;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, field, len) == 0) {
+            mask = strtoull(line + len, NULL, 16);
+            break;
+        }
+    }
+    fclose(f);
+    return mask;
+}
+
+void flight_check_signal(pid_t tid, int sig) {
+    char reason[96];
+    unsigned long long bit = 1ULL << (sig - 1);
+
+    // Só os sinais cuja ação padrão é gerar core (os "crashes" de verdade)
+    switch (sig) {
+    case SIGSEGV: case SIGBUS: case SIGILL: case SIGFPE: case SIGABRT: case SIGSYS:
+        break;
+    default:
+        return;
+    }
+    // Com tratador instalado (ou ignorado), o processo pode sobreviver ao sinal
+    if ((signal_mask(tid, "SigCgt:") | signal_mask(tid, "SigIgn:")) & bit) {
+        return;
+    }
+    snprintf(reason, sizeof(reason), "sinal fatal %s no tid %d", strsignal(sig), (int) tid);
+    flight_dump(reason);
+}
+
+void flight_dump(const char *reason) {
+    char path[64];
+    uint64_t n = total < capacity ? total : capacity;
+    uint64_t first = total - n;   // Registro mais antigo ainda no buffer
+    uint32_t start = (uint32_t) (first % capacity);
+    uint64_t until_wrap = capacity - start;
+    uint64_t head;
+    int failed;
+    FILE *f;
+
+    snprintf(path, sizeof(path), "syscall_flight_%d.bin", dumps + 1);
+    f = fopen(path, "w");
+    if (!f) {
+        perror("Erro ao gravar o gravador de voo");
+        return;
+    }
+    failed = fwrite(&header, sizeof(header), 1, f) != 1;
+    // O trecho mais antigo vai do início até o fim do vetor; o resto, do começo
+    head = n < until_wrap ? n : until_wrap;
+    failed |= fwrite(&slots[start], sizeof(slots[0]), head, f) != head;
+    if (n > until_wrap) {
+        failed |= fwrite(slots, sizeof(slots[0]), n - until_wrap, f) != n - until_wrap;
+    }
+    failed |= fclose(f) != 0;
+    if (failed) {
+        // Um arquivo cortado seria lido errado pelo decodificador: não fica nada
+        perror("Erro ao gravar o gravador de voo");
+        unlink(path);
+        return;
+    }
+    dumps++;
+
+    printf("[*] Gravador de voo: %llu registro(s) gravado(s) em %s (%s)\n",
+           (unsigned long long) n, path, reason);
+    fflush(stdout);
+}
+
+int flight_dumps(void) {
+    return dumps;
+}
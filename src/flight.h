@@ -0,0 +1,40 @@
+#include <stdint.h>
+#include <sys/types.h>
+#include "trace_format.h"
+
+#ifndef FLIGHT_H
+#define FLIGHT_H
+
+// Gravador de voo (modo -F N): os registros vão só para um buffer circular em
+// memória com as últimas N syscalls, sem nenhuma escrita em disco. O buffer é
+// gravado (no formato binário do -b, legível com ./bin/decode) em
+// syscall_flight_<k>.bin quando um gatilho dispara:
+//  - SIGUSR2 enviado ao logger;
+//  - um sinal fatal (não tratado pelo processo) prestes a ser entregue;
+//  - uma syscall escolhida com -T é chamada;
+//  - uma syscall escolhida com -E retorna erro.
+// Os gatilhos de syscall disparam no máximo uma vez por segundo, para que uma
+// rajada de erros não vire uma rajada de arquivos.
+
+int flight_init(uint32_t capacity);
+int flight_enabled(void);
+
+// Syscalls que disparam o gatilho ao serem chamadas (-T) ou ao falharem (-E).
+// lista: nomes ou números separados por vírgula; em -E, "todas" vale para qualquer syscall.
+int flight_trigger_calls(const char *lista);
+int flight_trigger_errors(const char *lista);
+
+// Guarda um registro (sobrescreve o mais antigo) e verifica os gatilhos de syscall
+void flight_record(const struct trace_record *rec);
+
+// Verifica se o sinal sig, parado para entrega à thread tid, vai matar o processo
+// (ação padrão de core/término e sem tratador) e, nesse caso, grava o buffer.
+void flight_check_signal(pid_t tid, int sig);
+
+// Grava o buffer agora; reason aparece na mensagem do console
+void flight_dump(const char *reason);
+
+// Quantidade de gravações feitas até agora
+int flight_dumps(void);
+
+#endif
@@ -0,0 +1,44 @@
+#include "histogram.h"
+
+void hist_merge(struct histogram *dst, const struct histogram *src) {
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        dst->buckets[i] += src->buckets[i];
+    }
+    dst->count += src->count;
+    if (src->max > dst->max) {
+        dst->max = src->max;
+    }
+}
+
+/**
+ * @brief Maior valor que cai na faixa de índice i.
+ */
+static uint64_t bucket_upper(unsigned int i) {
+    unsigned int shift;
+
+    if (i < HIST_SUB) {
+        return i;
+    }
+    shift = i / HIST_SUB - 1;
+    return (((uint64_t) (HIST_SUB + i % HIST_SUB)) << shift) + ((1ULL << shift) - 1);
+}
+
+uint64_t hist_percentile(const struct histogram *h, double p) {
+    uint64_t target, seen = 0;
+
+    if (h->count == 0) {
+        return 0;
+    }
+    target = (uint64_t) ((p / 100.0) * (double) h->count + 0.5);
+    if (target == 0) {
+        target = 1;
+    }
+    for (unsigned int i = 0; i < HIST_BUCKETS; i++) {
+        seen += h->buckets[i];
+        if (seen >= target) {
+            uint64_t upper = bucket_upper(i);
+            return upper < h->max ? upper : h->max;
+        }
+    }
+    return h->max;
+}
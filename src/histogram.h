@@ -0,0 +1,45 @@
+#include <stdint.h>
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+// Histograma log-linear (no estilo HDR) de latências em nanossegundos.
+// Cada potência de 2 é dividida em HIST_SUB faixas iguais, então o erro
+// relativo de qualquer percentil é de no máximo 1/HIST_SUB (12,5%),
+// com memória fixa e registro O(1) para qualquer valor de 64 bits.
+#define HIST_SUB_BITS 3
+#define HIST_SUB (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS ((64 - HIST_SUB_BITS + 1) * HIST_SUB)
+
+struct histogram {
+    uint64_t count;
+    uint64_t max;
+    uint64_t buckets[HIST_BUCKETS];
+};
+
+static inline unsigned int hist_bucket(uint64_t v) {
+    unsigned int msb, shift;
+
+    if (v < HIST_SUB) {
+        return (unsigned int) v;
+    }
+    msb = 63 - (unsigned int) __builtin_clzll(v);
+    shift = msb - HIST_SUB_BITS;
+    return (shift + 1) * HIST_SUB + (unsigned int) ((v >> shift) & (HIST_SUB - 1));
+}
+
+static inline void hist_record(struct histogram *h, uint64_t v) {
+    h->buckets[hist_bucket(v)]++;
+    h->count++;
+    if (v > h->max) {
+        h->max = v;
+    }
+}
+
+// Soma src em dst (histogramas de threads/processos diferentes se combinam assim)
+void hist_merge(struct histogram *dst, const struct histogram *src);
+
+// Valor abaixo do qual estão p% das amostras (limite superior da faixa)
+uint64_t hist_percentile(const struct histogram *h, double p);
+
+#endif
@@ -13,14 +13,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
 #include <unistd.h>
 #include <sys/ptrace.h>
 #include <sys/wait.h>
-#include <sys/user.h>   // Obrigatório para a struct user_regs_struct
 #include <sys/prctl.h>  // Obrigatório para prctl(PR_SET_PDEATHSIG)
 #include <signal.h>     // Obrigatório para SIGKILL
-#include <sys/uio.h>    // Obrigatório para a struct iovec
-#include <linux/elf.h>  // Obrigatório para a constante NT_PRSTATUS
+#include <getopt.h>     // Obrigatório para o parsing das opções (-f)
+#include <time.h>       // timer_create(), para acordar o waitpid() (ver wake_loop())
 
 #ifdef __linux__
 #include <sys/prctl.h>  // Específico do Linux
@@ -28,40 +28,367 @@
 
 // Inclui nosso módulo de parsing
 #include "parser.h"
+#include "seccomp_filter.h"
+#include "tracee_table.h"
+#include "output.h"
+#include "ring.h"
+#include "stats.h"
+#include "syscall_info.h"
+#include "attach.h"
+#include "sampling.h"
+#include "selfstats.h"
+#include "flight.h"
+#include "filter.h"
+#include "argdecode.h"
+#include "fdtable.h"
 
 
 // --- Variáveis Globais ---
-FILE *log_file = NULL;  // arquivo de log global
+enum output_format log_format = OUTPUT_TEXT; // texto (padrão) ou binário (-b)
+uint32_t ring_capacity = 0;                  // registros no buffer circular (-r); 0 = padrão
+int drop_when_full = 0;                      // -D: descarta registros em vez de bloquear
+int quiet_mode = 0;                          // -q: não espelha o log de texto no console
+uint32_t flight_capacity = 0;                // -F N: gravador de voo com as últimas N syscalls
+enum output_backend log_backend = OUTPUT_WRITE; // -m / -u / -U: forma de gravar o log
+int summary_mode = 0;                        // -c: só conta as syscalls, sem log por evento
+pid_t attach_pid = 0;                        // -p: processo já em execução a ser anexado
+unsigned int sample_every = 0;               // -s N: registra 1 em cada N syscalls por thread
+unsigned int duty_on_ms = 0;                 // -w ON/PERIODO: ciclo de trabalho, em ms
+unsigned int duty_period_ms = 0;
+int decode_args = 0;                         // -a N: decodifica os argumentos de ponteiro
+uint32_t decode_data_cap = 0;                //       copiando até N bytes de cada buffer
+int track_fds = 0;                           // -y: anota os descritores com o arquivo/socket
+int compress_runs = 0;                       // -z: compacta repetições de syscalls iguais
+
+// Marcado pelo sigint_handler; o loop principal encerra o rastreamento.
+volatile sig_atomic_t stop_requested = 0;
+// Marcado pelo sigusr1_handler; o loop principal imprime as estatísticas e continua.
+volatile sig_atomic_t dump_requested = 0;
+// Marcado pelo sigusr2_handler; o loop principal grava o gravador de voo (-F).
+volatile sig_atomic_t flight_requested = 0;
+// Marcado pelo sigalrm_handler; o loop principal troca a fase da amostragem (-w).
+volatile sig_atomic_t phase_requested = 0;
+// Ligado da última checagem das flags até o fim do waitpid() do loop principal
+static volatile sig_atomic_t wait_armed = 0;
+// Dispara SIGRTMIN para interromper o waitpid() (ver wake_loop())
+static timer_t wake_timer;
+static int wake_timer_ok = 0;
+
+// Modo filtrado (-f): apenas as syscalls selecionadas param o processo filho.
+int filtered_mode = 0;
+int filter_syscalls[SECCOMP_FILTER_MAX];
+int filter_count = 0;
 
 // --- Protótipos de Funções ---
-void wait_for_syscall(pid_t child_pid);
-void open_log_file();
-void close_log_file();
+void launch_command(char **cmd, long options);
+void trace_loop(void);
+void resume_tracee(struct tracee *t, int sig);
+void handle_syscall_stop(struct tracee *t, int expected_op);
+void handle_syscall_entry(struct tracee *t, const struct syscall_stop *st);
+void handle_syscall_exit(struct tracee *t, const struct syscall_stop *st);
+void emit_record(struct tracee *t);
+void usage(const char *prog);
 void sigint_handler(int sig);
+void sigusr1_handler(int sig);
+void sigalrm_handler(int sig);
+void sigusr2_handler(int sig);
+void sigwake_handler(int sig);
+void wake_loop(void);
 
 /**
  * @brief Ponto de entrada principal do programa.
  */
 int main(int argc, char *argv[])
 {
-    // Registra nosso manipulador para o sinal SIGINT (Ctrl+C)
-    signal(SIGINT, sigint_handler);
+    int opt;
+    int trigger_given = 0;
+    struct sigaction sa;
+
+    // Registra nosso manipulador para o sinal SIGINT (Ctrl+C).
+    // Sem SA_RESTART, para que o waitpid() do loop principal seja interrompido.
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = sigint_handler;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+
+    // SIGUSR1 (kill -USR1 <pid do logger>) imprime os contadores internos e as
+    // estatísticas do modo resumo sem parar o rastreamento
+    sa.sa_handler = sigusr1_handler;
+    sigaction(SIGUSR1, &sa, NULL);
+
+    // SIGUSR2 grava o gravador de voo (-F) sem parar o rastreamento
+    sa.sa_handler = sigusr2_handler;
+    sigaction(SIGUSR2, &sa, NULL);
+
+    // SIGALRM marca as trocas de fase da amostragem por ciclo de trabalho (-w)
+    sa.sa_handler = sigalrm_handler;
+    sigaction(SIGALRM, &sa, NULL);
+
+    // O '+' faz o getopt parar no primeiro argumento que não é opção,
+    // para que as opções do comando monitorado não sejam interpretadas aqui.
+    while ((opt = getopt(argc, argv, "+a:bce:f:mp:r:s:uw:yzDqUF:T:E:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'a':
+        {
+            char *end;
+            unsigned long cap = strtoul(optarg, &end, 10);
+            if (*optarg == '\0' || *end != '\0' || cap > ARGDECODE_DATA_MAX)
+            {
+                fprintf(stderr, "Limite de cópia inválido: %s (use 0 a %d bytes)\n", optarg, ARGDECODE_DATA_MAX);
+                return 1;
+            }
+            decode_data_cap = (uint32_t) cap;
+            decode_args = 1;
+            break;
+        }
+        case 'b':
+            log_format = OUTPUT_BINARY;
+            break;
+        case 'c':
+            summary_mode = 1;
+            break;
+        case 'e':
+            if (filter_parse(optarg) == -1)
+                return 1;
+            break;
+        case 'f':
+            filter_count = seccomp_filter_parse(optarg, filter_syscalls, SECCOMP_FILTER_MAX);
+            if (filter_count <= 0)
+            {
+                return 1;
+            }
+            filtered_mode = 1;
+            break;
+        case 'p':
+            attach_pid = (pid_t) atoi(optarg);
+            if (attach_pid <= 0)
+            {
+                fprintf(stderr, "PID inválido: %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'r':
+            ring_capacity = (uint32_t) strtoul(optarg, NULL, 10);
+            if (ring_capacity == 0)
+            {
+                fprintf(stderr, "Tamanho de buffer inválido: %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 's':
+            sample_every = (unsigned int) strtoul(optarg, NULL, 10);
+            if (sample_every == 0)
+            {
+                fprintf(stderr, "Taxa de amostragem inválida: %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'w':
+            if (sscanf(optarg, "%u/%u", &duty_on_ms, &duty_period_ms) != 2 ||
+                duty_on_ms == 0 || duty_on_ms >= duty_period_ms)
+            {
+                fprintf(stderr, "Ciclo de trabalho inválido: %s (use ON/PERIODO em ms, ex: 100/10000)\n", optarg);
+                return 1;
+            }
+            break;
+        case 'y':
+            track_fds = 1;
+            break;
+        case 'z':
+            compress_runs = 1;
+            break;
+        case 'D':
+            drop_when_full = 1;
+            break;
+        case 'q':
+            quiet_mode = 1;
+            break;
+        case 'm':
+            log_backend = OUTPUT_MMAP;
+            break;
+        case 'F':
+            flight_capacity = (uint32_t) strtoul(optarg, NULL, 10);
+            if (flight_capacity == 0)
+            {
+                fprintf(stderr, "Tamanho do gravador de voo inválido: %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'T':
+            if (flight_trigger_calls(optarg) <= 0)
+                return 1;
+            trigger_given = 1;
+            break;
+        case 'E':
+            if (flight_trigger_errors(optarg) <= 0)
+                return 1;
+            trigger_given = 1;
+            break;
+        case 'u':
+            log_backend = OUTPUT_URING;
+            break;
+        case 'U':
+            log_backend = OUTPUT_URING_DIRECT;
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
 
-    // Valida se o usuário passou um comando para ser executado.
-    if (argc < 2)
+    // Valida se o usuário passou um comando para ser executado (ou um PID com -p).
+    if (optind >= argc && attach_pid == 0)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    if (trigger_given && flight_capacity == 0)
+    {
+        fprintf(stderr, "As opções -T e -E só valem com o gravador de voo (-F N).\n");
+        return 1;
+    }
+    if (flight_capacity != 0 && summary_mode)
+    {
+        fprintf(stderr, "As opções -F e -c não podem ser usadas juntas.\n");
+        return 1;
+    }
+    if ((decode_args || track_fds) && (summary_mode || flight_capacity != 0))
+    {
+        // O resumo e o gravador de voo guardam só os registros de tamanho fixo
+        fprintf(stderr, "As opções -a e -y não podem ser usadas com -c ou -F.\n");
+        return 1;
+    }
+    if (compress_runs && (summary_mode || flight_capacity != 0))
+    {
+        fprintf(stderr, "A opção -z não pode ser usada com -c ou -F.\n");
+        return 1;
+    }
+    if (attach_pid != 0 && filtered_mode)
     {
-        fprintf(stderr, "Uso: %s <comando para executar>\n", argv[0]);
-        fprintf(stderr, "Exemplo: %s /bin/ls -l\n", argv[0]);
+        // O filtro seccomp só pode ser instalado pelo próprio processo, antes do execvp()
+        fprintf(stderr, "A opção -f não pode ser usada com -p.\n");
         return 1;
     }
 
+    // --- Processo Pai (o "Tracer") ---
+
+    if (summary_mode)
+    {
+        printf("[*] Modo resumo: as syscalls são apenas contadas; a tabela sai no final.\n\n");
+    }
+    else if (flight_capacity != 0)
+    {
+        if (flight_init(flight_capacity) == -1)
+        {
+            perror("Erro ao alocar o gravador de voo");
+            return 1;
+        }
+        printf("[*] Gravador de voo: últimas %u syscalls em memória; kill -USR2 %d grava o buffer.\n\n",
+               flight_capacity, (int) getpid());
+    }
+    else
+    {
+        if (log_format == OUTPUT_BINARY)
+        {
+            printf("[*] Modo binário: gravando em syscall_log.bin (use ./bin/decode para ler).\n\n");
+        }
+        output_open(log_format, log_backend, quiet_mode, ring_capacity, drop_when_full, compress_runs);
+        if (decode_args || track_fds)
+            argdecode_init(decode_args, decode_data_cap, track_fds);
+    }
+
+    // TRACECLONE/FORK/VFORK: threads e processos criados pelo alvo passam
+    //   a ser rastreados automaticamente (e herdam o filtro seccomp).
+    // TRACEEXEC: evita o SIGTRAP extra depois do execve.
+    long options = PTRACE_O_TRACESYSGOOD | PTRACE_O_TRACEEXEC |
+                   PTRACE_O_TRACECLONE | PTRACE_O_TRACEFORK | PTRACE_O_TRACEVFORK;
+
+    if (attach_pid != 0)
+    {
+        // Sem PTRACE_O_EXITKILL: se o logger morrer, o serviço deve continuar rodando.
+        uint64_t start = monotonic_ns();
+        int threads = attach_process(attach_pid, options);
+        if (threads <= 0)
+        {
+            fprintf(stderr, "Não foi possível anexar ao processo %d.\n", attach_pid);
+            if (!summary_mode && !flight_enabled())
+            {
+                output_close();
+                output_destroy();
+            }
+            return 1;
+        }
+        printf("[*] Anexado ao processo %d (%d thread(s)) em %.1f us.\n", attach_pid, threads,
+               (double) (monotonic_ns() - start) / 1e3);
+        printf("[*] Pressione Ctrl+C para soltar o processo (ele continua rodando) e salvar o log.\n\n");
+    }
+    else
+    {
+        launch_command(&argv[optind], options);
+    }
+    if (track_fds)
+    {
+        // A tabela de descritores parte do que o processo já tem aberto
+        pid_t first;
+        if (tracee_tids(&first, 1) == 1)
+            fdtable_seed_tracees(attach_pid != 0 ? attach_pid : first);
+    }
+
+    // Loop principal: vamos capturar cada syscall de todas as threads
+    sampling_init(sample_every, duty_on_ms, duty_period_ms);
+    selfstats_start();
+    fflush(stdout); // A thread de escrita usa write() direto: as mensagens acima vêm antes do log
+    trace_loop();
+
+    if (stop_requested)
+        printf("\n[*] Sinal de interrupção recebido. Encerrando de forma limpa...\n");
+    else if (attach_pid != 0)
+        printf("\n[*] Processo %d terminou.\n", attach_pid);
+    else
+        printf("\n[*] Processo filho terminou.\n");
+
+    if (attach_pid != 0 && tracee_count() > 0)
+    {
+        uint64_t start = monotonic_ns();
+        detach_all();
+        printf("[*] Processo %d solto em %.1f us.\n", attach_pid, (double) (monotonic_ns() - start) / 1e3);
+    }
+
+    if (sample_every > 1 || duty_period_ms > 0)
+        sampling_report(stdout, selfstats_stops());
+
+    // A thread de escrita termina antes do relatório, para ele contar o fim do
+    // log; o buffer circular (a ocupação máxima) só é liberado depois
+    if (!summary_mode && !flight_enabled())
+        output_close();
+    selfstats_print(stderr);
+
+    if (summary_mode)
+        stats_print(stdout, sampling_scale());
+    else if (flight_enabled())
+        printf("[*] Gravador de voo: %d gravação(ões) do buffer.\n", flight_dumps());
+    else
+        output_destroy();
+
+    return 0;
+}
+
+/**
+ * @brief Cria o processo filho que executa o comando e o deixa pronto para o loop principal.
+ * * @param cmd O comando e seus argumentos (terminado em NULL).
+ * * @param options As opções de ptrace (PTRACE_O_*).
+ */
+void launch_command(char **cmd, long options)
+{
     // Usa fork() para criar um novo processo.
     pid_t child_pid = fork();
 
     if (child_pid == -1)
     {
         perror("fork"); // Se fork() falhar.
-        return 1;
+        exit(1);
     }
 
     if (child_pid == 0)
@@ -77,136 +404,414 @@ int main(int argc, char *argv[])
         prctl(PR_SET_PDEATHSIG, SIGKILL);
         #endif
 
+        // 2.1 No modo filtrado, o filtro seccomp só pode ser instalado depois que
+        //     o pai ativar PTRACE_O_TRACESECCOMP; caso contrário o kernel responde
+        //     ENOSYS às syscalls marcadas com RET_TRACE (inclusive o execve abaixo).
+        //     Por isso paramos aqui e esperamos o pai configurar as opções.
+        if (filtered_mode)
+        {
+            raise(SIGSTOP);
+            if (seccomp_filter_install(filter_syscalls, filter_count) == -1)
+            {
+                perror("seccomp");
+                exit(1);
+            }
+        }
+
         // 3. Substitui a imagem do processo filho pelo comando que queremos monitorar.
         //    O sistema operacional vai parar o processo aqui e notificar o pai (por causa do PTRACE_TRACEME).
-        execvp(argv[1], &argv[1]);
+        execvp(cmd[0], cmd);
 
         // Se execvp() retornar, significa que deu erro.
         perror("execvp");
         exit(1);
     }
-    else
+
+    printf("[*] Iniciando tracer para o processo filho com PID: %d\n", child_pid);
+    printf("[*] Comando: %s\n\n", cmd[0]);
+    if (filtered_mode)
     {
-        // --- Processo Pai (o "Tracer") ---
-
-        printf("[*] Iniciando tracer para o processo filho com PID: %d\n", child_pid);
-        printf("[*] Comando: %s\n\n", argv[1]);
-        printf("[*] Pressione Ctrl+C para parar o rastreamento e salvar o log.\n\n");
-
-        open_log_file();
-
-        // Espera o filho parar na chamada execvp()
-        wait(NULL);
-        ptrace(PTRACE_SETOPTIONS, child_pid, NULL, PTRACE_O_TRACESYSGOOD);
-
-        // Loop principal: vamos capturar cada syscall
-        while(1) {
-             // Estrutura para armazenar os registradores da CPU do processo filho.
-            // Declaramos uma vez aqui, e cada bloco a preenche.
-            struct user_regs_struct regs;
-            long long syscall_number;
-            long long return_value;
-
-            // --- TRATAMENTO DA ENTRADA DA SYSCALL ---
-            wait_for_syscall(child_pid);
-
-            #if defined(__x86_64__)
-                ptrace(PTRACE_GETREGS, child_pid, NULL, &regs);
-                syscall_number = regs.orig_rax;
-            #elif defined(__aarch64__)
-                struct iovec iov = { .iov_base = &regs, .iov_len = sizeof(regs) };
-                ptrace(PTRACE_GETREGSET, child_pid, NT_PRSTATUS, &iov);
-                syscall_number = regs.regs[8];
-            #else
-                #error "Arquitetura não suportada."
-            #endif
-
-            // Agora com o número da syscall, chamamos o parser
-            const char *syscall_name = get_syscall_name(syscall_number);
-            
-            // A função do parser agora cuida de TODO o logging (arquivo e console)
-            log_syscall_args(child_pid, &regs, syscall_name, log_file);
-
-
-            // --- TRATAMENTO DA SAÍDA DA SYSCALL ---
-            wait_for_syscall(child_pid);
-
-            #if defined(__x86_64__)
-                ptrace(PTRACE_GETREGS, child_pid, NULL, &regs);
-                return_value = regs.rax;
-            #elif defined(__aarch64__)
-                iov.iov_base = &regs;
-                iov.iov_len = sizeof(regs);
-                ptrace(PTRACE_GETREGSET, child_pid, NT_PRSTATUS, &iov);
-                return_value = regs.regs[0];
-            #endif
-
-            // Loga o valor de retorno no arquivo e no console
-            fprintf(log_file, "  -> Retorno = %lld\n\n", return_value);
-            printf("  -> Retorno = %lld\n\n", return_value);
-            fflush(log_file);
-               
-        } // Fim do while(1)
+        printf("[*] Modo filtrado: %d syscall(s) selecionada(s) via seccomp.\n\n", filter_count);
     }
+    printf("[*] Pressione Ctrl+C para parar o rastreamento e salvar o log.\n\n");
 
-    return 0;
+    // Espera o filho parar na chamada execvp() (ou no SIGSTOP, no modo filtrado)
+    waitpid(child_pid, NULL, 0);
+
+    // EXITKILL: o filho existe só para ser rastreado; morre junto com o logger.
+    // TRACESECCOMP (modo filtrado): o filho para em cada SECCOMP_RET_TRACE.
+    options |= PTRACE_O_EXITKILL;
+    if (filtered_mode)
+    {
+        options |= PTRACE_O_TRACESECCOMP;
+    }
+    ptrace(PTRACE_SETOPTIONS, child_pid, NULL, options);
+
+    tracee_add(child_pid);
+    resume_tracee(tracee_find(child_pid), 0);
 }
 
 /**
- * @brief Avança o processo filho até a próxima entrada/saída de syscall e espera.
- * * @param child_pid O PID do processo filho a ser monitorado.
+ * @brief Loop de eventos: atende as paradas de todas as threads rastreadas na ordem em que chegam.
  */
-void wait_for_syscall(pid_t child_pid)
+void trace_loop(void)
 {
     int status;
-    while (1)
+    pid_t tid;
+    uint64_t mark;
+    struct sigaction sa;
+    struct sigevent sev;
+
+    // Sem SA_RESTART: o SIGRTMIN do wake_timer interrompe o waitpid()
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = sigwake_handler;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGRTMIN, &sa, NULL);
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_notify = SIGEV_SIGNAL;
+    sev.sigev_signo = SIGRTMIN;
+    wake_timer_ok = timer_create(CLOCK_MONOTONIC, &sev, &wake_timer) == 0;
+
+    // waitpid(-1, __WALL) recebe eventos de qualquer thread ou processo rastreado,
+    // então uma thread bloqueada numa syscall não atrasa o atendimento das outras.
+    while (tracee_count() > 0 && !stop_requested)
     {
-        // Continua o processo filho, mas para na próxima chamada de sistema.
-        ptrace(PTRACE_SYSCALL, child_pid, NULL, NULL);
+        if (dump_requested)
+        {
+            dump_requested = 0;
+            selfstats_print(stderr);
+            if (summary_mode)
+                stats_print(stdout, sampling_scale());
+        }
+        if (flight_requested)
+        {
+            flight_requested = 0;
+            if (flight_enabled())
+                flight_dump("SIGUSR2");
+        }
+        if (phase_requested)
+        {
+            phase_requested = 0;
+            sampling_toggle(!filtered_mode);
+        }
 
-        // Espera pelo filho.
-        waitpid(child_pid, &status, 0);
+        // Um sinal que chegue depois das checagens acima e antes de o waitpid()
+        // bloquear não o interrompe, e a próxima parada pode não vir (fase
+        // livre do -w, modo filtrado). Nesse intervalo, o manipulador arma o
+        // wake_timer, que interrompe o waitpid() logo depois (ver wake_loop()).
+        wait_armed = 1;
+        if (stop_requested || dump_requested || flight_requested || phase_requested)
+        {
+            wait_armed = 0;
+            continue;
+        }
+        mark = monotonic_ns();
+        tid = waitpid(-1, &status, __WALL);
+        wait_armed = 0;
+        selfstats_add(SELF_WAIT, 1, monotonic_ns() - mark);
+        if (tid == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            break; // ECHILD: não há mais ninguém para rastrear
+        }
+
+        struct tracee *t = tracee_find(tid);
+
+        // WIFEXITED: Verifica se a thread/processo terminou sua execução.
+        // WIFSIGNALED: Verifica se ele foi morto por um sinal.
+        if (WIFEXITED(status) || WIFSIGNALED(status))
+        {
+            if (t && t->in_syscall && t->sampled)
+            {
+                // Syscalls que não retornam (exit, exit_group): registra só a entrada
+                emit_record(t);
+            }
+            tracee_remove(tid);
+            continue;
+        }
+
+        if (!WIFSTOPPED(status))
+            continue;
+        selfstats_stop();
 
-        // WIFSTOPPED: Verifica se o filho parou por um sinal.
-        // WSTOPSIG: Pega o sinal que parou o filho.
-        // Queremos continuar apenas se o sinal for de uma trap de syscall (SIGTRAP).
-        if (WIFSTOPPED(status) && (WSTOPSIG(status) & 0x80))
+        // Uma thread nova pode parar antes de o pai reportar o PTRACE_EVENT_CLONE.
+        if (!t)
         {
-            return; // Parou em uma syscall, retorna para o loop principal
+            t = tracee_add(tid);
+            t->attach_pending = 1;
         }
 
-        // WIFEXITED: Verifica se o processo filho terminou sua execução.
-        if (WIFEXITED(status))
+        int sig = WSTOPSIG(status);
+        int event = status >> 16;
+        int deliver = 0; // Sinal a ser repassado na retomada
+
+        if (sig == (SIGTRAP | 0x80))
+        {
+            // Parada de syscall (PTRACE_SYSCALL): entrada ou saída
+            handle_syscall_stop(t, t->in_syscall ? SYSCALL_STOP_EXIT : SYSCALL_STOP_ENTRY);
+        }
+        else if (sig == SIGTRAP && event == PTRACE_EVENT_SECCOMP)
+        {
+            // Entrada de uma syscall selecionada pelo filtro
+            handle_syscall_stop(t, SYSCALL_STOP_SECCOMP);
+        }
+        else if (sig == SIGTRAP && (event == PTRACE_EVENT_CLONE || event == PTRACE_EVENT_FORK ||
+                                    event == PTRACE_EVENT_VFORK))
+        {
+            unsigned long new_tid;
+            ptrace(PTRACE_GETEVENTMSG, tid, NULL, &new_tid);
+            if (!tracee_find((pid_t) new_tid))
+            {
+                tracee_add((pid_t) new_tid)->attach_pending = 1;
+                t = tracee_find(tid); // A inserção pode ter realocado a tabela
+            }
+            if (track_fds)
+            {
+                // Uma thread (mesmo tgid) compartilha os descritores; fork e
+                // vfork (e clone sem CLONE_THREAD) recebem uma cópia
+                struct tracee *child = tracee_find((pid_t) new_tid);
+                fdtable_inherit(t, child, event == PTRACE_EVENT_CLONE && tracee_tgid(child) == tracee_tgid(t));
+            }
+        }
+        else if (sig == SIGTRAP && event == PTRACE_EVENT_EXEC)
+        {
+            // Um execve feito por outra thread troca o tid dela pelo do líder
+            // do grupo; as demais threads já foram encerradas pelo kernel.
+            unsigned long old_tid;
+            ptrace(PTRACE_GETEVENTMSG, tid, NULL, &old_tid);
+            if ((pid_t) old_tid != tid)
+            {
+                struct tracee *old = tracee_find((pid_t) old_tid);
+                if (old)
+                {
+                    struct arg_arena *args = t->args;
+                    t->in_syscall = old->in_syscall;
+                    t->sampled = old->sampled;
+                    t->rec = old->rec;
+                    t->rec.tid = (uint32_t) tid;
+                    // O caminho do execve foi copiado na arena da thread antiga
+                    t->args = old->args;
+                    old->args = args;
+                    tracee_remove((pid_t) old_tid);
+                    t = tracee_find(tid);
+                }
+            }
+            if (track_fds)
+                fdtable_exec(t);
+        }
+        else if (t->attach_pending && (sig == SIGSTOP || event == PTRACE_EVENT_STOP))
+        {
+            // Parada inicial de uma thread/processo recém-criado: não repassa o SIGSTOP
+            // (com -p, os filhos de um processo anexado param com PTRACE_EVENT_STOP)
+            t->attach_pending = 0;
+        }
+        else if (sig == SIGSTOP && event == 0 && t->wake_pending)
+        {
+            // SIGSTOP enviado pela amostragem para retomar a thread com PTRACE_SYSCALL
+            t->wake_pending = 0;
+        }
+        else if (event == PTRACE_EVENT_STOP)
+        {
+            // Group-stop de um processo anexado (-p): continua parado, mas observado,
+            // até receber SIGCONT
+            if (sig == SIGSTOP || sig == SIGTSTP || sig == SIGTTIN || sig == SIGTTOU)
+            {
+                ptrace(PTRACE_LISTEN, tid, NULL, NULL);
+                continue;
+            }
+        }
+        else if (sig != SIGTRAP)
         {
-            printf("\n[*] Processo filho terminou.\n");
-            close_log_file(); // Fecha o log antes de sair
-            exit(0);
+            deliver = sig; // Sinal comum destinado ao processo: repassa
+            if (flight_enabled())
+                flight_check_signal(tid, sig);
         }
+
+        mark = monotonic_ns();
+        resume_tracee(t, deliver);
+        selfstats_add(SELF_RESUME, 1, monotonic_ns() - mark);
+    }
+    if (wake_timer_ok)
+    {
+        wake_timer_ok = 0;
+        timer_delete(wake_timer);
     }
 }
 
 /**
- * @brief Abre o arquivo de log para escrita.
+ * @brief Retoma uma thread rastreada até a próxima parada que nos interessa.
+ * * @param t A thread a ser retomada.
+ * * @param sig Sinal a ser entregue (0 para nenhum).
  */
-void open_log_file() 
+void resume_tracee(struct tracee *t, int sig)
 {
-    log_file = fopen("syscall_log.txt", "w");
-    if (!log_file) {
-        perror("Erro ao abrir arquivo de log");
-        exit(1);
+    // No modo filtrado a thread roda com PTRACE_CONT (sem paradas) até a
+    // próxima syscall selecionada; só usamos PTRACE_SYSCALL para pegar a saída
+    // da syscall atual. A partir da parada do seccomp, o PTRACE_SYSCALL leva
+    // direto à parada de saída da mesma syscall. Fora da fase ativa da
+    // amostragem (-w), todas as threads rodam assim, sem paradas.
+    if (!t->in_syscall && (filtered_mode || !sampling_active()))
+        ptrace(PTRACE_CONT, t->tid, NULL, sig);
+    else
+        ptrace(PTRACE_SYSCALL, t->tid, NULL, sig);
+}
+
+/**
+ * @brief Trata uma parada de syscall (entrada, saída ou seccomp).
+ * * @param t A thread parada.
+ * * @param expected_op O tipo de parada esperado pela alternância entrada/saída;
+ *   só é usado em kernels sem PTRACE_GET_SYSCALL_INFO.
+ */
+void handle_syscall_stop(struct tracee *t, int expected_op)
+{
+    struct syscall_stop st;
+    uint64_t start = monotonic_ns();
+    int ret = syscall_stop_read(t->tid, expected_op, &st);
+
+    selfstats_add(SELF_READ, 1, monotonic_ns() - start);
+    if (ret == -1)
+        return; // A thread morreu; o waitpid() vai reportar a saída
+
+    if (st.op == SYSCALL_STOP_ENTRY || st.op == SYSCALL_STOP_SECCOMP)
+        handle_syscall_entry(t, &st);
+    else if (st.op == SYSCALL_STOP_EXIT)
+        handle_syscall_exit(t, &st);
+}
+
+/**
+ * @brief Trata a parada de entrada de uma syscall: guarda os argumentos até a saída.
+ */
+void handle_syscall_entry(struct tracee *t, const struct syscall_stop *st)
+{
+    if (!sampling_active())
+    {
+        // Fase inativa do ciclo: resume_tracee() solta a thread com PTRACE_CONT
+        t->in_syscall = 0;
+        return;
+    }
+    if (track_fds)
+    {
+        // A tabela de descritores acompanha todas as syscalls, mesmo as que
+        // não são registradas (fora da amostra ou do filtro -e)
+        t->rec.nr = st->nr;
+        memcpy(t->rec.args, st->args, sizeof(t->rec.args));
+    }
+    if (filter_active() &&
+        !filter_entry(st->nr, t->tid, filter_needs_tgid() ? tracee_tgid(t) : 0))
+    {
+        // Fora das expressões -e: mesmo tratamento de uma syscall fora da amostra
+        t->sampled = 0;
+        t->in_syscall = !filtered_mode;
+        return;
     }
-    fprintf(log_file, "--- Início do Log de Chamadas de Sistema ---\n\n");
+    if (!sampling_take(t))
+    {
+        // Fora da amostra 1 em N. No modo filtrado nem esperamos a saída;
+        // nos outros ainda precisamos dela para manter a alternância.
+        t->sampled = 0;
+        t->in_syscall = !filtered_mode;
+        return;
+    }
+
+    t->sampled = 1;
+    t->rec.ts_ns = monotonic_ns();
+    t->rec.tid = (uint32_t) t->tid;
+    t->rec.nr = st->nr;
+    memcpy(t->rec.args, st->args, sizeof(t->rec.args));
+    t->rec.flags = TRACE_F_ENTRY;
+    t->rec.ret = 0;
+    t->rec.dur_ns = 0;
+    t->in_syscall = 1;
+    if (argdecode_enabled())
+        argdecode_entry(t);
+}
+
+/**
+ * @brief Trata a parada de saída de uma syscall e registra a chamada completa.
+ */
+void handle_syscall_exit(struct tracee *t, const struct syscall_stop *st)
+{
+    int ret_is_fd = 0;
+    int entered = t->in_syscall; // 0 numa saída sem a entrada (syscall em curso ao anexar)
+
+    t->in_syscall = 0;
+    if (track_fds && entered)
+        ret_is_fd = fdtable_exit(t, t->rec.nr, t->rec.args, st->ret);
+    if (!t->sampled)
+        return;
+
+    // Latência vista pelo tracer: inclui o tempo que o kernel leva para nos
+    // entregar as duas paradas, mas usa o mesmo relógio da entrada.
+    t->rec.dur_ns = monotonic_ns() - t->rec.ts_ns;
+    t->rec.ret = st->ret;
+    t->rec.flags |= TRACE_F_EXIT;
+    if (argdecode_enabled())
+        argdecode_exit(t, ret_is_fd);
+
+    // Com várias threads, entradas e saídas de tids diferentes se intercalam.
+    // Por isso o registro da syscall (argumentos + retorno) só é emitido na saída.
+    emit_record(t);
 }
 
 /**
- * @brief Fecha o arquivo de log de forma segura.
+ * @brief Entrega uma syscall terminada ao log ou, no modo resumo, aos contadores.
  */
-void close_log_file() {
-    if (log_file) {
-        fprintf(log_file, "\n--- Fim do Log ---\n");
-        fclose(log_file);
-        log_file = NULL; // Evita double-free
+void emit_record(struct tracee *t)
+{
+    uint64_t start = monotonic_ns();
+
+    // Condições sobre o retorno (-e status=failed, -e ret<0...)
+    if (!filter_exit(&t->rec))
+        return;
+
+    if (summary_mode)
+        stats_record(&t->rec, tracee_tgid(t));
+    else if (flight_enabled())
+        flight_record(&t->rec);
+    else
+    {
+        const void *payload = NULL;
+        uint32_t len = argdecode_enabled() ? argdecode_payload(t, &payload) : 0;
+        output_record(&t->rec, payload, len);
     }
+    selfstats_add(SELF_RECORD, 1, monotonic_ns() - start);
+}
+
+/**
+ * @brief Mostra a forma de uso do programa.
+ */
+void usage(const char *prog)
+{
+    fprintf(stderr, "Uso: %s [opções] <comando para executar>\n", prog);
+    fprintf(stderr, "     %s [opções] -p <pid>\n", prog);
+    fprintf(stderr, "Exemplo: %s /bin/ls -l\n", prog);
+    fprintf(stderr, "Exemplo: %s -f openat,connect,execve /bin/ls -l\n", prog);
+    fprintf(stderr, "  -a N  Decodifica os ponteiros: caminhos, endereços de socket e até N bytes dos\n");
+    fprintf(stderr, "      dados de read/write/sendto/recvfrom (N de 0 a %d)\n", ARGDECODE_DATA_MAX);
+    fprintf(stderr, "  -b  Modo binário: grava registros compactos em syscall_log.bin (leia com ./bin/decode)\n");
+    fprintf(stderr, "  -c  Modo resumo: conta chamadas, erros e tempo por syscall e imprime uma tabela e os\n");
+    fprintf(stderr, "      percentis de latência no final (ou a qualquer momento com kill -USR1 <pid do logger>)\n");
+    fprintf(stderr, "  -e EXPR  Filtro: trace=%%file,%%network,!futex | status=failed | ret<0 | pid=1,2 | tid=3\n");
+    fprintf(stderr, "  -f syscall1,syscall2,...  Modo filtrado: registra apenas as syscalls da lista (via seccomp-BPF)\n");
+    fprintf(stderr, "  -p PID  Anexa a um processo já em execução (todas as threads); Ctrl+C solta o processo\n");
+    fprintf(stderr, "  -r N  Tamanho do buffer entre o rastreamento e a thread de escrita, em registros (padrão %d)\n",
+            RING_DEFAULT_CAPACITY);
+    fprintf(stderr, "  -s N  Amostragem: registra 1 em cada N syscalls de cada thread\n");
+    fprintf(stderr, "  -w ON/PERIODO  Ciclo de trabalho: rastreia ON ms a cada PERIODO ms (ex: 100/10000);\n");
+    fprintf(stderr, "      no resto do tempo o processo roda sem paradas. Com -c, os totais são estimados\n");
+    fprintf(stderr, "  -y  Anota os descritores com o arquivo ou socket a que se referem (ex: 3 </etc/hosts>)\n");
+    fprintf(stderr, "  -z  Compacta repetições (a mesma syscall ou um ciclo de até %d) de cada thread num só\n",
+            TRACE_REPEAT_PERIOD_MAX);
+    fprintf(stderr, "      registro com a contagem e o tempo; ./bin/decode as expande de volta\n");
+    fprintf(stderr, "  -D  Com o buffer cheio, descarta registros (e os conta) em vez de pausar o rastreamento\n");
+    fprintf(stderr, "  -m  Grava o log num arquivo mapeado em memória (reservado com fallocate em blocos de 64 MiB)\n");
+    fprintf(stderr, "  -u  Grava o log com escritas assíncronas pelo io_uring (-U: idem, com O_DIRECT)\n");
+    fprintf(stderr, "  -F N  Gravador de voo: guarda só as últimas N syscalls em memória e as grava em\n");
+    fprintf(stderr, "      syscall_flight_<k>.bin com kill -USR2 <pid do logger>, num sinal fatal ou num gatilho:\n");
+    fprintf(stderr, "  -T syscall1,...  Gatilho: a syscall foi chamada\n");
+    fprintf(stderr, "  -E syscall1,...|todas  Gatilho: a syscall retornou erro\n");
+    fprintf(stderr, "  -q  Modo silencioso: grava o log de texto só no arquivo, sem repeti-lo no console\n");
 }
 
 /**
@@ -214,7 +819,58 @@ void close_log_file() {
  */
 void sigint_handler(int sig) {
     (void)sig; // Evita warning de "unused parameter"
-    printf("\n[*] Sinal de interrupção recebido. Encerrando de forma limpa...\n");
-    close_log_file();
-    exit(0);
+    // Apenas sinaliza: o log é esvaziado e fechado pela thread principal,
+    // fora do contexto do sinal, depois que o loop principal terminar.
+    stop_requested = 1;
+    wake_loop();
+}
+
+/**
+ * @brief Manipulador para o sinal SIGUSR2: pede a gravação do gravador de voo.
+ */
+void sigusr2_handler(int sig) {
+    (void)sig;
+    flight_requested = 1;
+    wake_loop();
+}
+
+/**
+ * @brief Manipulador para o sinal SIGALRM: pede a troca de fase da amostragem.
+ */
+void sigalrm_handler(int sig) {
+    (void)sig;
+    phase_requested = 1;
+    wake_loop();
+}
+
+/**
+ * @brief Manipulador para o sinal SIGUSR1: pede uma impressão das estatísticas.
+ */
+void sigusr1_handler(int sig) {
+    (void)sig;
+    dump_requested = 1;
+    wake_loop();
+}
+
+/**
+ * @brief Chamada pelos manipuladores depois de marcar uma flag: se o loop
+ * principal pode já ter passado pelas checagens e estar bloqueado no
+ * waitpid(), arma o wake_timer para daqui a 1 ms.
+ */
+void wake_loop(void) {
+    struct itimerspec its = { { 0, 0 }, { 0, 1000000 } };
+
+    if (wait_armed && wake_timer_ok) {
+        timer_settime(wake_timer, 0, &its, NULL);
+    }
+}
+
+/**
+ * @brief Manipulador para o SIGRTMIN do wake_timer: o waitpid() foi interrompido.
+ * Enquanto o loop não sair dele, o timer é rearmado (o primeiro disparo
+ * pode ter chegado antes de o waitpid() bloquear).
+ */
+void sigwake_handler(int sig) {
+    (void)sig;
+    wake_loop();
 }
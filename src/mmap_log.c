@@ -0,0 +1,105 @@
+#define _GNU_SOURCE
+#include "mmap_log.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/**
+ * @brief Garante que o arquivo tenha pelo menos size bytes reservados.
+ */
+static int reserve(struct mmap_log *m, off_t size) {
+    if (size <= m->allocated) {
+        return 0;
+    }
+    // fallocate() reserva os blocos de verdade (sem surpresas de disco cheio
+    // no meio de um memcpy); sistemas de arquivos sem suporte ficam com um
+    // arquivo esparso, que também pode ser mapeado.
+    if (fallocate(m->fd, 0, m->allocated, size - m->allocated) == -1) {
+        if (errno != EOPNOTSUPP && errno != ENOSYS) {
+            return -1;
+        }
+        if (ftruncate(m->fd, size) == -1) {
+            return -1;
+        }
+    }
+    m->allocated = size;
+    return 0;
+}
+
+/**
+ * @brief Mapeia a janela que contém a posição atual.
+ */
+static int map_window(struct mmap_log *m) {
+    off_t off = m->pos - m->pos % (off_t) MMAP_LOG_CHUNK;
+    void *p;
+
+    if (m->window) {
+        munmap(m->window, MMAP_LOG_CHUNK);
+        m->window = NULL;
+    }
+    if (reserve(m, off + (off_t) MMAP_LOG_CHUNK) == -1) {
+        return -1;
+    }
+    p = mmap(NULL, MMAP_LOG_CHUNK, PROT_WRITE, MAP_SHARED, m->fd, off);
+    if (p == MAP_FAILED) {
+        return -1;
+    }
+    m->window = p;
+    m->window_off = off;
+    return 0;
+}
+
+int mmap_log_open(struct mmap_log *m, int fd, off_t start) {
+    memset(m, 0, sizeof(*m));
+    m->fd = fd;
+    m->pos = start;
+    m->allocated = start;
+    if (map_window(m) == -1) {
+        int err = errno;
+        // Desfaz a reserva, para que o chamador possa continuar com write()
+        if (ftruncate(fd, start) == -1) {
+            err = errno;
+        }
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
+
+int mmap_log_write(struct mmap_log *m, const void *buf, size_t len, size_t *copied) {
+    const char *src = buf;
+
+    *copied = 0;
+    while (len > 0) {
+        size_t at = (size_t) (m->pos - m->window_off);
+        size_t n = MMAP_LOG_CHUNK - at;
+
+        if (n == 0) {
+            // Janela cheia: passa para o próximo bloco do arquivo
+            if (map_window(m) == -1) {
+                return -1;
+            }
+            continue;
+        }
+        if (n > len) {
+            n = len;
+        }
+        memcpy(m->window + at, src, n);
+        m->pos += (off_t) n;
+        src += n;
+        len -= n;
+        *copied += n;
+    }
+    return 0;
+}
+
+int mmap_log_close(struct mmap_log *m) {
+    if (m->window) {
+        munmap(m->window, MMAP_LOG_CHUNK);
+        m->window = NULL;
+    }
+    // Devolve o espaço reservado e não usado
+    return ftruncate(m->fd, m->pos);
+}
@@ -0,0 +1,32 @@
+#include <stddef.h>
+#include <sys/types.h>
+
+#ifndef MMAP_LOG_H
+#define MMAP_LOG_H
+
+// Janela mapeada do arquivo de log (modo -m). O arquivo é estendido com
+// fallocate() em blocos de MMAP_LOG_CHUNK bytes e só a janela atual fica
+// mapeada; os registros são copiados direto para a memória, sem uma syscall
+// por gravação. No fechamento o arquivo é truncado para o tamanho real.
+#define MMAP_LOG_CHUNK (64UL * 1024 * 1024)
+
+struct mmap_log {
+    int fd;
+    char *window;      // Mapeamento de [window_off, window_off + MMAP_LOG_CHUNK)
+    off_t window_off;
+    off_t pos;         // Próximo byte a gravar (posição absoluta no arquivo)
+    off_t allocated;   // Tamanho já reservado no disco
+};
+
+// Começa a gravar em fd a partir da posição start (depois do cabeçalho).
+// Retorna 0 ou -1 (com errno) se não foi possível reservar ou mapear.
+int mmap_log_open(struct mmap_log *m, int fd, off_t start);
+
+// Copia len bytes para o arquivo, trocando de janela quando necessário.
+// copied recebe os bytes já copiados (mesmo em erro: mmap_log_close() os mantém).
+int mmap_log_write(struct mmap_log *m, const void *buf, size_t len, size_t *copied);
+
+// Desfaz o mapeamento e trunca o arquivo no último byte gravado.
+int mmap_log_close(struct mmap_log *m);
+
+#endif
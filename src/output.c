@@ -0,0 +1,394 @@
+#define _GNU_SOURCE // O_DIRECT
+#include "output.h"
+#include "parser.h"
+#include "ring.h"
+#include "selfstats.h"
+#include "mmap_log.h"
+#include "uring_log.h"
+#include "repeat.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <signal.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+// Buffer de texto da thread de escrita: um lote de registros formatados vai
+// para cada destino numa única write()
+#define OUTPUT_TEXT_BATCH (64 * 1024)
+
+static FILE *log_file = NULL;  // arquivo de log (só a thread de escrita usa)
+static enum output_format log_format = OUTPUT_TEXT;
+static enum output_backend log_backend = OUTPUT_WRITE;
+static struct mmap_log log_map;  // Janela mapeada (OUTPUT_MMAP)
+static struct uring_log log_uring; // Fila do io_uring (OUTPUT_URING*)
+static int uring_fd = -1;        // Descritor usado pelo io_uring (com O_DIRECT, um segundo open())
+static int echo_console = 1;   // 0 no modo silencioso (-q)
+static int compress_runs = 0;  // 1 com a compactação de repetições (-z)
+static char text_batch[OUTPUT_TEXT_BATCH];
+static size_t batch_len = 0;     // Bytes prontos em text_batch
+static uint64_t batch_write_ns = 0; // Tempo gasto nas escritas do lote atual
+static struct trace_file_header header;
+
+static struct ring ring;
+static pthread_t writer;
+static uint64_t records_written = 0;
+
+uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+void trace_header_init(struct trace_file_header *hdr) {
+    struct timespec ts;
+
+    memset(hdr, 0, sizeof(*hdr));
+    memcpy(hdr->magic, TRACE_MAGIC, sizeof(hdr->magic));
+    hdr->version = TRACE_VERSION;
+    hdr->arch = TRACE_ARCH_NATIVE;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    hdr->start_realtime_ns = (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+    hdr->start_monotonic_ns = monotonic_ns();
+}
+
+/**
+ * @brief Grava len bytes em fd, repetindo em escritas parciais.
+ */
+static void write_all(int fd, const char *buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return; // Disco cheio, stdout fechado...: o rastreamento continua
+        }
+        buf += n;
+        len -= (size_t) n;
+    }
+}
+
+/**
+ * @brief Prepara o io_uring sobre o arquivo de log. Retorna -1 se não for possível.
+ */
+static int open_uring(const char *path) {
+    int direct = log_backend == OUTPUT_URING_DIRECT;
+
+    uring_fd = fileno(log_file);
+    if (direct) {
+        // O_DIRECT precisa de um descritor próprio; alguns sistemas de arquivos
+        // (tmpfs, por exemplo) não o aceitam
+        uring_fd = open(path, O_WRONLY | O_DIRECT);
+        if (uring_fd == -1) {
+            perror("Erro ao abrir o log com O_DIRECT; usando io_uring sem O_DIRECT");
+            uring_fd = fileno(log_file);
+            direct = 0;
+            log_backend = OUTPUT_URING;
+        }
+    }
+    if (uring_log_open(&log_uring, uring_fd, direct) == -1) {
+        if (uring_fd != fileno(log_file)) {
+            close(uring_fd);
+        }
+        uring_fd = -1;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Espera as escritas pendentes do io_uring e libera a fila.
+ */
+static void close_uring(void) {
+    if (uring_log_close(&log_uring) == -1) {
+        perror("Erro ao concluir as escritas do io_uring");
+    }
+    if (uring_fd != fileno(log_file)) {
+        close(uring_fd);
+    }
+    uring_fd = -1;
+}
+
+/**
+ * @brief Grava no arquivo de log pelo backend escolhido.
+ */
+static void sink_write(const void *buf, size_t len) {
+    if (log_backend == OUTPUT_URING || log_backend == OUTPUT_URING_DIRECT) {
+        size_t copied;
+        if (uring_log_write(&log_uring, buf, len, &copied) == 0) {
+            return;
+        }
+        // Grava o que já estava nos buffers (incluindo o começo de buf), trunca
+        // no fim e continua com write() a partir do resto
+        perror("Erro ao gravar pelo io_uring; usando write()");
+        close_uring();
+        lseek(fileno(log_file), 0, SEEK_END);
+        log_backend = OUTPUT_WRITE;
+        buf = (const char *) buf + copied;
+        len -= copied;
+    }
+    if (log_backend == OUTPUT_MMAP) {
+        size_t copied;
+        if (mmap_log_write(&log_map, buf, len, &copied) == 0) {
+            return;
+        }
+        // Sem espaço para mapear/reservar: fecha a janela (truncando no que
+        // já foi gravado) e continua com write() a partir daí
+        perror("Erro ao gravar no log mapeado; usando write()");
+        mmap_log_close(&log_map);
+        lseek(fileno(log_file), 0, SEEK_END);
+        log_backend = OUTPUT_WRITE;
+        buf = (const char *) buf + copied;
+        len -= copied;
+    }
+    write_all(fileno(log_file), buf, len);
+}
+
+/**
+ * @brief Envia o texto acumulado ao arquivo de log e, se ligado, ao console.
+ */
+static void flush_text(size_t len) {
+    sink_write(text_batch, len);
+    if (echo_console) {
+        write_all(STDOUT_FILENO, text_batch, len);
+    }
+}
+
+/**
+ * @brief Conta os registros de um trecho do buffer, pulando os payloads.
+ * * @param whole Recebe quantas posições vão para o arquivo (sem o enchimento do fim).
+ */
+static size_t count_records(const struct trace_record *recs, size_t n, size_t *whole) {
+    size_t count = 0;
+    size_t i = 0;
+
+    while (i < n && !(recs[i].flags & TRACE_F_PAD)) {
+        i += 1 + (recs[i].flags & TRACE_F_ARGS ? TRACE_PAYLOAD_SLOTS(recs[i].payload) : 0);
+        count++;
+    }
+    *whole = i;
+    return count;
+}
+
+/**
+ * @brief Grava o lote acumulado em text_batch.
+ */
+static void batch_flush(void) {
+    uint64_t t = monotonic_ns();
+
+    if (log_format == OUTPUT_BINARY) {
+        sink_write(text_batch, batch_len);
+    } else {
+        flush_text(batch_len);
+    }
+    batch_write_ns += monotonic_ns() - t;
+    selfstats_bytes(batch_len);
+    batch_len = 0;
+}
+
+/**
+ * @brief Acrescenta um registro ao lote, formatado uma única vez (ou copiado, no modo binário).
+ */
+static void batch_add(const struct trace_record *rec, const void *payload) {
+    size_t slots = rec->flags & TRACE_F_PAYLOAD ? TRACE_PAYLOAD_SLOTS(rec->payload) : 0;
+    size_t need = log_format == OUTPUT_BINARY ? (1 + slots) * sizeof(*rec) : TRACE_TEXT_SIZE(rec);
+
+    if (batch_len + need > sizeof(text_batch)) {
+        batch_flush();
+    }
+    if (log_format == OUTPUT_BINARY) {
+        memcpy(text_batch + batch_len, rec, sizeof(*rec));
+        memcpy(text_batch + batch_len + sizeof(*rec), payload, slots * sizeof(*rec));
+        batch_len += need;
+    } else {
+        batch_len += format_syscall_record(text_batch + batch_len, &header, rec, payload);
+    }
+    // Uma repetição conta todas as syscalls que representa
+    records_written += rec->flags & TRACE_F_REPEAT ? ((const struct trace_repeat *) payload)->count : 1;
+}
+
+/**
+ * @brief Thread de escrita: esvazia o buffer circular em lotes até ele ser fechado.
+ */
+static void *writer_main(void *arg) {
+    const struct trace_record *recs;
+    size_t n, whole, count;
+    uint64_t start;
+
+    (void) arg;
+    while ((n = ring_peek(&ring, &recs)) > 0) {
+        start = monotonic_ns();
+        // Registro e payload nunca são divididos na volta do buffer (ver ring_push())
+        count = count_records(recs, n, &whole);
+        if (log_format == OUTPUT_BINARY && !compress_runs) {
+            // Os registros já estão no formato do arquivo: grava o lote direto do buffer
+            sink_write(recs, whole * sizeof(recs[0]));
+            selfstats_bytes(whole * sizeof(recs[0]));
+            selfstats_add(SELF_WRITE, 1, monotonic_ns() - start);
+            records_written += count;
+        } else {
+            // O lote inteiro vai para o arquivo (e para o console) com uma write() cada
+            uint64_t newest = 0;
+
+            batch_write_ns = 0;
+            for (size_t i = 0; i < whole;) {
+                const void *payload = recs[i].flags & TRACE_F_ARGS ? &recs[i + 1] : NULL;
+
+                if (!compress_runs) {
+                    batch_add(&recs[i], payload);
+                } else if (!payload) {
+                    repeat_push(&recs[i]);
+                } else {
+                    // Mantém a ordem da thread: o que ela tinha guardado vai antes
+                    repeat_flush_tid(recs[i].tid);
+                    batch_add(&recs[i], payload);
+                }
+                newest = recs[i].ts_ns > newest ? recs[i].ts_ns : newest;
+                i += 1 + (payload ? TRACE_PAYLOAD_SLOTS(recs[i].payload) : 0);
+            }
+            if (compress_runs) {
+                repeat_flush_older(newest);
+            }
+            if (batch_len > 0) {
+                batch_flush();
+            }
+            selfstats_add(SELF_FORMAT, count, monotonic_ns() - start - batch_write_ns);
+            selfstats_add(SELF_WRITE, 1, batch_write_ns);
+        }
+        ring_release(&ring, n);
+    }
+
+    // Fim do rastreamento: as repetições ainda abertas vão para o log
+    if (compress_runs) {
+        start = monotonic_ns();
+        batch_write_ns = 0;
+        repeat_finish();
+        if (batch_len > 0) {
+            batch_flush();
+        }
+        selfstats_add(SELF_FORMAT, 0, monotonic_ns() - start - batch_write_ns);
+        selfstats_add(SELF_WRITE, 1, batch_write_ns);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Abre o arquivo de log para escrita e inicia a thread de escrita.
+ */
+void output_open(enum output_format format, enum output_backend backend, int quiet,
+                 uint32_t ring_capacity, int drop_when_full, int compress) {
+    const char *path = format == OUTPUT_BINARY ? "syscall_log.bin" : "syscall_log.txt";
+    sigset_t all, old;
+
+    log_format = format;
+    echo_console = !quiet;
+    // "w+": o mmap() do modo -m exige o arquivo aberto também para leitura
+    log_file = fopen(path, "w+");
+    if (!log_file) {
+        perror("Erro ao abrir arquivo de log");
+        exit(1);
+    }
+
+    // Os dois relógios são lidos uma única vez, no início do rastreamento
+    trace_header_init(&header);
+
+    // O arquivo inteiro, a partir do cabeçalho, é gravado pelo backend escolhido
+    log_backend = backend;
+    if (backend == OUTPUT_MMAP && mmap_log_open(&log_map, fileno(log_file), 0) == -1) {
+        perror("Erro ao mapear o arquivo de log; usando write()");
+        log_backend = OUTPUT_WRITE;
+    }
+    if ((backend == OUTPUT_URING || backend == OUTPUT_URING_DIRECT) && open_uring(path) == -1) {
+        perror("io_uring indisponível; usando write()");
+        log_backend = OUTPUT_WRITE;
+    }
+
+    if (format == OUTPUT_BINARY) {
+        sink_write(&header, sizeof(header));
+    } else {
+        static const char banner[] = "--- Início do Log de Chamadas de Sistema ---\n\n";
+        sink_write(banner, sizeof(banner) - 1);
+    }
+
+    if (compress && repeat_init(batch_add) == -1) {
+        perror("Erro ao alocar a compactação de repetições");
+        exit(1);
+    }
+    compress_runs = compress;
+
+    if (ring_init(&ring, ring_capacity ? ring_capacity : RING_DEFAULT_CAPACITY, drop_when_full) == -1) {
+        perror("Erro ao alocar o buffer circular");
+        exit(1);
+    }
+
+    // A thread de escrita não recebe sinais: o SIGINT deve cair na thread
+    // principal, que é quem encerra o rastreamento.
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    if (pthread_create(&writer, NULL, writer_main, NULL) != 0) {
+        fprintf(stderr, "Erro ao criar a thread de escrita\n");
+        exit(1);
+    }
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+}
+
+/**
+ * @brief Registra uma syscall no log (apenas copia para o buffer circular).
+ */
+void output_record(const struct trace_record *rec, const void *payload, uint32_t payload_len) {
+    struct trace_record copy;
+
+    // Payload que ocuparia mais da metade do buffer (-r pequeno): vai só o registro
+    if (payload_len == 0 || 2 * (1 + TRACE_PAYLOAD_SLOTS(payload_len)) > (size_t) ring.mask + 1) {
+        ring_push(&ring, rec, NULL, 0);
+        return;
+    }
+    copy = *rec;
+    copy.flags |= TRACE_F_ARGS;
+    copy.payload = payload_len;
+    ring_push(&ring, &copy, payload, payload_len);
+}
+
+uint32_t output_ring_high_water(void) {
+    return ring.slots ? ring.high_water : 0;
+}
+
+/**
+ * @brief Esvazia o buffer, encerra a thread de escrita e fecha o arquivo de log.
+ */
+void output_close(void) {
+    if (log_file) {
+        ring_close(&ring);
+        pthread_join(writer, NULL);
+
+        if (log_format == OUTPUT_TEXT) {
+            static const char trailer[] = "\n--- Fim do Log ---\n";
+            sink_write(trailer, sizeof(trailer) - 1);
+        }
+        if (log_backend == OUTPUT_MMAP && mmap_log_close(&log_map) == -1) {
+            perror("Erro ao truncar o log mapeado");
+        }
+        if (log_backend == OUTPUT_URING || log_backend == OUTPUT_URING_DIRECT) {
+            close_uring();
+        }
+        fclose(log_file);
+        log_file = NULL; // Evita double-free
+
+        printf("[*] Registros gravados: %llu\n", (unsigned long long) records_written);
+        if (compress_runs) {
+            printf("[*] Repetições compactadas: %llu syscalls em %llu registros\n",
+                   (unsigned long long) repeat_events(), (unsigned long long) repeat_groups());
+        }
+        if (ring.dropped > 0) {
+            printf("[*] Registros descartados (buffer cheio): %llu\n", (unsigned long long) ring.dropped);
+        }
+    }
+}
+
+void output_destroy(void) {
+    ring_destroy(&ring);
+}
@@ -0,0 +1,46 @@
+#include "trace_format.h"
+#include <stdint.h>
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+// Formato de saída do log
+enum output_format {
+    OUTPUT_TEXT,   // syscall_log.txt legível, espelhado no console
+    OUTPUT_BINARY  // syscall_log.bin com registros de tamanho fixo (ver trace_format.h)
+};
+
+// Como o arquivo de log é gravado pela thread de escrita
+enum output_backend {
+    OUTPUT_WRITE,  // write() direto no descritor, um por lote
+    OUTPUT_MMAP,   // Cópia para o arquivo mapeado em memória (ver mmap_log.h)
+    OUTPUT_URING,  // Escritas assíncronas em lotes de 1 MiB pelo io_uring (ver uring_log.h)
+    OUTPUT_URING_DIRECT // Idem, com O_DIRECT (sem passar pelo cache de páginas)
+};
+
+// O loop do ptrace só copia cada registro para um buffer circular; a
+// formatação e a escrita em disco ficam numa thread separada.
+// backend: forma de gravar o arquivo (cai para write() se o escolhido falhar).
+// quiet: 1 não espelha o log de texto no console.
+// ring_capacity: tamanho do buffer em registros (0 usa o padrão).
+// drop_when_full: 1 descarta registros com o buffer cheio; 0 bloqueia o rastreamento.
+// compress: 1 compacta as repetições de cada thread antes de gravar (ver repeat.h).
+void output_open(enum output_format format, enum output_backend backend, int quiet,
+                 uint32_t ring_capacity, int drop_when_full, int compress);
+// payload: argumentos decodificados (-a) gravados depois do registro (NULL e 0 sem eles)
+void output_record(const struct trace_record *rec, const void *payload, uint32_t payload_len);
+// Fecha o buffer, espera a thread de escrita esvaziá-lo e fecha o arquivo
+void output_close(void);
+// Libera o buffer circular (depois do output_close() e do relatório de contadores)
+void output_destroy(void);
+
+// Maior ocupação do buffer circular até agora, em registros (0 sem log)
+uint32_t output_ring_high_water(void);
+
+// Instante atual em CLOCK_MONOTONIC, em nanossegundos
+uint64_t monotonic_ns(void);
+
+// Preenche um cabeçalho do formato binário com o par de relógios de agora
+void trace_header_init(struct trace_file_header *hdr);
+
+#endif
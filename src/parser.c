@@ -1,73 +1,385 @@
 #include "parser.h"
-#include <sys/user.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
+#include <stddef.h>
 #include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
 #include <time.h>
 
-const char* get_syscall_name(long syscall_number) {
-    #if defined(__x86_64__)
+const char* get_syscall_name_arch(uint32_t arch, long syscall_number) {
+    // As duas tabelas são compiladas em qualquer máquina, para que o
+    // decodificador leia logs gerados em outra arquitetura
+    switch (arch) {
+    case TRACE_ARCH_X86_64:
         switch (syscall_number) {
             #include "x86_64_table.h"
-             default: return "unknown_syscall";
+            default: return "unknown_syscall";
         }
-    #elif defined(__aarch64__)
+    case TRACE_ARCH_AARCH64:
         switch (syscall_number) {
             #include "aarch64_table.h"
             default: return "unknown_syscall";
         }
-    #else
-        #error "Arquitetura não suportada."
-    #endif
+    default:
+        return "unknown_syscall";
+    }
 }
 
-void log_syscall_args(pid_t pid, struct user_regs_struct *regs, const char *syscall_name, FILE *log_file) {
-    // Esta parte inicial é independente da arquitetura
-    time_t now = time(NULL);
-    struct tm *tm_info = localtime(&now);
-    char timestamp[26];
-    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", tm_info);
-
-    // Imprime o cabeçalho no arquivo e no terminal
-    fprintf(log_file, "[%s] [PID %d] Syscall: %s\n", timestamp, pid, syscall_name);
-    printf("[%s] [PID %d] Syscall: %s\n", timestamp, pid, syscall_name);
+const char* get_syscall_name(long syscall_number) {
+    return get_syscall_name_arch(TRACE_ARCH_NATIVE, syscall_number);
+}
 
+unsigned int get_syscall_classes(long syscall_number) {
     #if defined(__x86_64__)
-        // Registradores de argumento para x86-64
-        fprintf(log_file, "  arg1(rdi): %lld\n", (long long) regs->rdi);
-        fprintf(log_file, "  arg2(rsi): %lld\n", (long long) regs->rsi);
-        fprintf(log_file, "  arg3(rdx): %lld\n", (long long) regs->rdx);
-        fprintf(log_file, "  arg4(r10): %lld\n", (long long) regs->r10);
-        fprintf(log_file, "  arg5(r8):  %lld\n", (long long) regs->r8);
-        fprintf(log_file, "  arg6(r9):  %lld\n", (long long) regs->r9);
-
-        printf("  arg1(rdi): %lld\n", (long long) regs->rdi);
-        printf("  arg2(rsi): %lld\n", (long long) regs->rsi);
-        printf("  arg3(rdx): %lld\n", (long long) regs->rdx);
-        printf("  arg4(r10): %lld\n", (long long) regs->r10);
-        printf("  arg5(r8):  %lld\n", (long long) regs->r8);
-        printf("  arg6(r9):  %lld\n", (long long) regs->r9);
-
+        switch (syscall_number) {
+            #include "x86_64_classes.h"
+            default: return 0;
+        }
     #elif defined(__aarch64__)
-        // Registradores de argumento para aarch64 (ARM64)
-        fprintf(log_file, "  arg1(x0): %lld\n", (long long) regs->regs[0]);
-        fprintf(log_file, "  arg2(x1): %lld\n", (long long) regs->regs[1]);
-        fprintf(log_file, "  arg3(x2): %lld\n", (long long) regs->regs[2]);
-        fprintf(log_file, "  arg4(x3): %lld\n", (long long) regs->regs[3]);
-        fprintf(log_file, "  arg5(x4): %lld\n", (long long) regs->regs[4]);
-        fprintf(log_file, "  arg6(x5): %lld\n", (long long) regs->regs[5]);
-
-        printf("  arg1(x0): %lld\n", (long long) regs->regs[0]);
-        printf("  arg2(x1): %lld\n", (long long) regs->regs[1]);
-        printf("  arg3(x2): %lld\n", (long long) regs->regs[2]);
-        printf("  arg4(x3): %lld\n", (long long) regs->regs[3]);
-        printf("  arg5(x4): %lld\n", (long long) regs->regs[4]);
-        printf("  arg6(x5): %lld\n", (long long) regs->regs[5]);
+        switch (syscall_number) {
+            #include "aarch64_classes.h"
+            default: return 0;
+        }
+    #endif
+}
 
+unsigned int get_syscall_arg_types(long syscall_number) {
+    #if defined(__x86_64__)
+        switch (syscall_number) {
+            #include "x86_64_args.h"
+            default: return 0;
+        }
+    #elif defined(__aarch64__)
+        switch (syscall_number) {
+            #include "aarch64_args.h"
+            default: return 0;
+        }
     #endif
+}
+
+long get_syscall_number(const char *syscall_name) {
+    // Busca reversa na mesma tabela usada por get_syscall_name().
+    // Só é usada na inicialização (parsing de opções), então a busca linear basta.
+    for (long nr = 0; nr < SYSCALL_NR_MAX; nr++) {
+        if (strcmp(get_syscall_name(nr), syscall_name) == 0) {
+            return nr;
+        }
+    }
+    return -1;
+}
+
+// Prefixos das linhas de argumento de cada arquitetura (indexados pela
+// etiqueta TRACE_ARCH_* do cabeçalho), já com o recuo e o tamanho calculado
+// em tempo de compilação (copiados com um memcpy só)
+#define PREFIX(s) { s, sizeof(s) - 1 }
+struct prefix {
+    const char *text;
+    size_t len;
+};
+static const struct prefix arg_prefixes[][6] = {
+    [TRACE_ARCH_X86_64] = {
+        PREFIX("  arg1(rdi): "), PREFIX("  arg2(rsi): "), PREFIX("  arg3(rdx): "),
+        PREFIX("  arg4(r10): "), PREFIX("  arg5(r8):  "), PREFIX("  arg6(r9):  ")
+    },
+    [TRACE_ARCH_AARCH64] = {
+        PREFIX("  arg1(x0): "), PREFIX("  arg2(x1): "), PREFIX("  arg3(x2): "),
+        PREFIX("  arg4(x3): "), PREFIX("  arg5(x4): "), PREFIX("  arg6(x5): ")
+    },
+};
+
+// Pares de dígitos "00".."99": converte dois dígitos por divisão
+static const char digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static char *put_str(char *p, const char *s, size_t len) {
+    memcpy(p, s, len);
+    return p + len;
+}
+
+static char *put_u64(char *p, uint64_t v) {
+    char tmp[20];
+    char *t = tmp + sizeof(tmp);
+
+    while (v >= 100) {
+        unsigned int pair = (unsigned int) (v % 100) * 2;
+        v /= 100;
+        *--t = digit_pairs[pair + 1];
+        *--t = digit_pairs[pair];
+    }
+    if (v >= 10) {
+        *--t = digit_pairs[v * 2 + 1];
+        *--t = digit_pairs[v * 2];
+    } else {
+        *--t = (char) ('0' + v);
+    }
+    return put_str(p, t, (size_t) (tmp + sizeof(tmp) - t));
+}
+
+static char *put_hex(char *p, uint64_t v) {
+    static const char hex[] = "0123456789abcdef";
+    int digits = 16 - (__builtin_clzll(v | 1) / 4);
+
+    *p++ = '0';
+    *p++ = 'x';
+    for (int i = digits - 1; i >= 0; i--) {
+        *p++ = hex[(v >> (i * 4)) & 0xf];
+    }
+    return p;
+}
+
+// Valores que não cabem em 32 bits (e não são negativos pequenos, como -EBADF
+// ou AT_FDCWD) são quase sempre endereços: saem em hexadecimal.
+static char *put_value(char *p, uint64_t v) {
+    int64_t sv = (int64_t) v;
+
+    if (sv < 0 && sv >= -(int64_t) 0x80000000LL) {
+        *p++ = '-';
+        return put_u64(p, (uint64_t) -sv);
+    }
+    if (v > 0xffffffffULL) {
+        return put_hex(p, v);
+    }
+    return put_u64(p, v);
+}
+
+/**
+ * @brief Escreve dados como o conteúdo de uma string C, com escapes como \n e \x00.
+ */
+static char *put_escaped(char *p, const uint8_t *data, uint32_t len) {
+    static const char hex[] = "0123456789abcdef";
+
+    for (uint32_t i = 0; i < len; i++) {
+        uint8_t c = data[i];
+        switch (c) {
+        case '\n': *p++ = '\\'; *p++ = 'n'; break;
+        case '\t': *p++ = '\\'; *p++ = 't'; break;
+        case '\r': *p++ = '\\'; *p++ = 'r'; break;
+        case '"':
+        case '\\':
+            *p++ = '\\';
+            *p++ = (char) c;
+            break;
+        default:
+            if (c >= 0x20 && c < 0x7f) {
+                *p++ = (char) c;
+            } else {
+                *p++ = '\\';
+                *p++ = 'x';
+                *p++ = hex[c >> 4];
+                *p++ = hex[c & 0xf];
+            }
+        }
+    }
+    return p;
+}
+
+static char *put_quoted(char *p, const uint8_t *data, uint32_t len, int truncated) {
+    *p++ = '"';
+    p = put_escaped(p, data, len);
+    *p++ = '"';
+    if (truncated) {
+        p = put_str(p, "...", 3);
+    }
+    return p;
+}
+
+/**
+ * @brief Escreve o que um descritor é, entre < e >, como o strace -y: </etc/hosts>.
+ */
+static char *put_fd(char *p, const uint8_t *data, uint32_t len, int truncated) {
+    *p++ = '<';
+    p = put_escaped(p, data, len);
+    if (truncated) {
+        p = put_str(p, "...", 3);
+    }
+    *p++ = '>';
+    return p;
+}
+
+/**
+ * @brief Escreve um endereço de socket: {inet 1.2.3.4:80}, {inet6 [::1]:80}, {unix "/run/x"}.
+ */
+static char *put_sockaddr(char *p, const uint8_t *data, uint32_t len) {
+    char addr[INET6_ADDRSTRLEN];
+    sa_family_t family;
+
+    if (len < sizeof(family)) {
+        return put_str(p, "{?}", 3);
+    }
+    memcpy(&family, data, sizeof(family));
+
+    if (family == AF_UNIX) {
+        const uint8_t *path = data + offsetof(struct sockaddr_un, sun_path);
+        uint32_t max = len - (uint32_t) offsetof(struct sockaddr_un, sun_path);
+        // Sockets abstratos começam com '\0' e usam o tamanho inteiro
+        uint32_t plen = max > 0 && path[0] == '\0' ? max : (uint32_t) strnlen((const char *) path, max);
+        p = put_str(p, "{unix ", 6);
+        p = put_quoted(p, path, plen, 0);
+        *p++ = '}';
+    } else if (family == AF_INET && len >= sizeof(struct sockaddr_in)) {
+        struct sockaddr_in in;
+        memcpy(&in, data, sizeof(in));
+        inet_ntop(AF_INET, &in.sin_addr, addr, sizeof(addr));
+        p = put_str(p, "{inet ", 6);
+        p = put_str(p, addr, strlen(addr));
+        *p++ = ':';
+        p = put_u64(p, ntohs(in.sin_port));
+        *p++ = '}';
+    } else if (family == AF_INET6 && len >= sizeof(struct sockaddr_in6)) {
+        struct sockaddr_in6 in6;
+        memcpy(&in6, data, sizeof(in6));
+        inet_ntop(AF_INET6, &in6.sin6_addr, addr, sizeof(addr));
+        p = put_str(p, "{inet6 [", 8);
+        p = put_str(p, addr, strlen(addr));
+        p = put_str(p, "]:", 2);
+        p = put_u64(p, ntohs(in6.sin6_port));
+        *p++ = '}';
+    } else {
+        p = put_str(p, "{família ", 10);
+        p = put_u64(p, family);
+        *p++ = '}';
+    }
+    return p;
+}
+
+// Data do último registro formatado: só é refeita quando o segundo muda.
+// Usada apenas pela thread de escrita (ou pelo decodificador).
+static time_t cached_second = (time_t) -1;
+static char cached_date[32];   // "[AAAA-MM-DD HH:MM:SS] [PID "
+static size_t cached_date_len;
+
+/**
+ * @brief Formata uma repetição (-z): o primeiro ciclo e uma linha com a contagem e o intervalo.
+ */
+static size_t format_repeat(char *buf, const struct trace_file_header *hdr, const struct trace_record *rec,
+                            const void *payload) {
+    struct trace_record first = *rec;
+    struct trace_repeat rep;
+    unsigned int frac;
+    char *p = buf;
+
+    first.flags &= ~(uint32_t) TRACE_F_REPEAT;
+    first.payload = 0;
+    p += format_syscall_record(p, hdr, &first, NULL);
+    if (!payload || rec->payload < sizeof(rep)) {
+        return (size_t) (p - buf);
+    }
+    memcpy(&rep, payload, sizeof(rep));
+    for (uint32_t i = 1; i < rep.period && i < TRACE_REPEAT_PERIOD_MAX &&
+                         sizeof(rep) + i * sizeof(first) <= rec->payload; i++) {
+        struct trace_record next;
+        memcpy(&next, (const uint8_t *) payload + sizeof(rep) + (i - 1) * sizeof(next), sizeof(next));
+        p += format_syscall_record(p, hdr, &next, NULL);
+    }
+
+    p = put_str(p, "  >>> Repetição: ", 19);
+    p = put_u64(p, rep.count);
+    p = put_str(p, " syscalls (ciclo de ", 20);
+    p = put_u64(p, rep.period);
+    p = put_str(p, ") em ", 5);
+    p = put_u64(p, rep.span_ns / 1000000);
+    *p++ = '.';
+    frac = (unsigned int) (rep.span_ns / 1000 % 1000);
+    *p++ = (char) ('0' + frac / 100);
+    *p++ = (char) ('0' + frac / 10 % 10);
+    *p++ = (char) ('0' + frac % 10);
+    p = put_str(p, " ms\n\n", 5);
+    return (size_t) (p - buf);
+}
+
+size_t format_syscall_record(char *buf, const struct trace_file_header *hdr, const struct trace_record *rec,
+                             const void *payload) {
+    if (rec->flags & TRACE_F_REPEAT) {
+        return format_repeat(buf, hdr, rec, payload);
+    }
+
+    // Converte o instante monotônico do registro em hora de parede
+    time_t now = (time_t) ((hdr->start_realtime_ns + (rec->ts_ns - hdr->start_monotonic_ns)) / 1000000000ULL);
+    const char *name = get_syscall_name_arch(hdr->arch, rec->nr);
+    const struct prefix *prefixes = arg_prefixes[hdr->arch == TRACE_ARCH_AARCH64 ? TRACE_ARCH_AARCH64
+                                                                                  : TRACE_ARCH_X86_64];
+    const struct trace_arg *decoded[7] = { NULL }; // Seis argumentos e o retorno
+    char *p = buf;
+
+    // Argumentos decodificados (-a), indexados pela posição do argumento
+    if (payload && (rec->flags & TRACE_F_ARGS)) {
+        const uint8_t *q = payload;
+        const uint8_t *end = q + rec->payload;
+        while ((size_t) (end - q) >= sizeof(struct trace_arg)) {
+            const struct trace_arg *a = (const struct trace_arg *) q;
+            if (a->len > (size_t) (end - q) - sizeof(*a)) {
+                break;
+            }
+            if (a->arg <= TRACE_ARG_RET) {
+                decoded[a->arg] = a;
+            }
+            q += sizeof(*a) + ((a->len + 7) & ~7U);
+        }
+    }
+
+    if (now != cached_second) {
+        struct tm tm_info;
+        localtime_r(&now, &tm_info);
+        cached_date_len = strftime(cached_date, sizeof(cached_date), "[%Y-%m-%d %H:%M:%S] [PID ", &tm_info);
+        cached_second = now;
+    }
+
+    p = put_str(p, cached_date, cached_date_len);
+    p = put_u64(p, rec->tid);
+    p = put_str(p, "] Syscall: ", 11);
+    p = put_str(p, name, strlen(name));
+    *p++ = '\n';
+    for (int i = 0; i < 6; i++) {
+        p = put_str(p, prefixes[i].text, prefixes[i].len);
+        p = put_value(p, rec->args[i]);
+        if (decoded[i]) {
+            const uint8_t *data = (const uint8_t *) (decoded[i] + 1);
+            *p++ = ' ';
+            if (decoded[i]->kind == TRACE_ARG_SOCKADDR) {
+                p = put_sockaddr(p, data, decoded[i]->len);
+            } else if (decoded[i]->kind == TRACE_ARG_FD) {
+                p = put_fd(p, data, decoded[i]->len, decoded[i]->truncated);
+            } else {
+                p = put_quoted(p, data, decoded[i]->len, decoded[i]->truncated);
+            }
+        }
+        *p++ = '\n';
+    }
 
-    fflush(log_file); // Garante que seja escrito no arquivo imediatamente
     // Adiciona uma linha em branco para separar as syscalls
-    fprintf(log_file, "\n");
-    printf("\n");
+    *p++ = '\n';
+
+    // Syscalls que não retornam (exit_group) não têm a parada de saída
+    if (rec->flags & TRACE_F_EXIT) {
+        unsigned int frac = (unsigned int) (rec->dur_ns % 1000);
+        p = put_str(p, "  -> Retorno = ", 15);
+        p = put_value(p, (uint64_t) rec->ret);
+        if (decoded[TRACE_ARG_RET]) {
+            *p++ = ' ';
+            p = put_fd(p, (const uint8_t *) (decoded[TRACE_ARG_RET] + 1), decoded[TRACE_ARG_RET]->len,
+                       decoded[TRACE_ARG_RET]->truncated);
+        }
+        p = put_str(p, "  (", 3);
+        p = put_u64(p, rec->dur_ns / 1000);
+        *p++ = '.';
+        *p++ = (char) ('0' + frac / 100);
+        *p++ = (char) ('0' + frac / 10 % 10);
+        *p++ = (char) ('0' + frac % 10);
+        p = put_str(p, " us)\n\n", 6);
+    }
+    return (size_t) (p - buf);
+}
+
+int log_syscall_record(FILE *out, const struct trace_file_header *hdr, const struct trace_record *rec,
+                       const void *payload) {
+    static char buf[TRACE_TEXT_ARGS_MAX];
+    size_t len = format_syscall_record(buf, hdr, rec, payload);
+
+    return (int) fwrite(buf, 1, len, out);
 }
@@ -1,12 +1,57 @@
 #include <stdio.h>  // Para declarar FILE
 #include <sys/types.h>
-#include <sys/user.h>  
+#include "trace_format.h"
 
 #ifndef PARSER_H
 #define PARSER_H
 
-// Para struct user_regs_struct
-void log_syscall_args(pid_t pid, struct user_regs_struct *regs, const char *syscall_name,FILE *log_file);
+// Limite superior (exclusivo) dos números de syscall presentes nas tabelas
+// x86_64_table.h e aarch64_table.h. Usado para dimensionar tabelas densas.
+#define SYSCALL_NR_MAX 512
+
+// Tamanho máximo de um registro no layout de texto, sem argumentos decodificados
+#define TRACE_TEXT_MAX 512
+// Com argumentos decodificados: cada byte de dados vira até 4 caracteres ("\xff");
+// uma repetição (-z) mostra o primeiro ciclo e uma linha de resumo
+#define TRACE_TEXT_SIZE(rec) \
+    ((rec)->flags & TRACE_F_REPEAT ? TRACE_TEXT_REPEAT_MAX : \
+     TRACE_TEXT_MAX + ((rec)->flags & TRACE_F_ARGS ? 4 * (size_t) (rec)->payload + 7 * 16 : 0))
+#define TRACE_TEXT_REPEAT_MAX ((TRACE_REPEAT_PERIOD_MAX + 1) * TRACE_TEXT_MAX)
+#define TRACE_TEXT_ARGS_MAX (TRACE_TEXT_MAX + 4 * TRACE_PAYLOAD_MAX + 7 * 16)
+
+// Formata um registro no layout de texto do syscall_log.txt em buf (com pelo
+// menos TRACE_TEXT_SIZE(rec) bytes); retorna o tamanho, sem '\0'. payload é
+// o que segue o registro (NULL sem TRACE_F_PAYLOAD): argumentos
+// decodificados ou, com TRACE_F_REPEAT, o resto da repetição.
+size_t format_syscall_record(char *buf, const struct trace_file_header *hdr, const struct trace_record *rec,
+                             const void *payload);
+
+// Escreve um registro no layout de texto do syscall_log.txt; retorna os bytes escritos
+int log_syscall_record(FILE *out, const struct trace_file_header *hdr, const struct trace_record *rec,
+                       const void *payload);
+// Nome da syscall na arquitetura do logger (get_syscall_name) ou numa
+// arquitetura qualquer, dada pela etiqueta TRACE_ARCH_* do cabeçalho
 const char* get_syscall_name(long syscall_number);
+const char* get_syscall_name_arch(uint32_t arch, long syscall_number);
+long get_syscall_number(const char *syscall_name);
+
+// Classes de syscalls (x86_64_classes.h / aarch64_classes.h), usadas nos
+// conjuntos %file, %network... das expressões de filtro (-e trace=...)
+#define SYSCALL_CLASS_FILE    0x01  // Recebe um caminho de arquivo
+#define SYSCALL_CLASS_DESC    0x02  // Recebe ou cria um descritor de arquivo
+#define SYSCALL_CLASS_NETWORK 0x04  // Sockets
+#define SYSCALL_CLASS_PROCESS 0x08  // Ciclo de vida de processos e threads
+#define SYSCALL_CLASS_MEMORY  0x10  // Mapeamentos de memória
+#define SYSCALL_CLASS_SIGNAL  0x20  // Sinais
+#define SYSCALL_CLASS_IPC     0x40  // IPC System V e filas POSIX
+unsigned int get_syscall_classes(long syscall_number);
+
+// Tipos dos seis argumentos de uma syscall (x86_64_args.h / aarch64_args.h),
+// 4 bits cada (TRACE_ARG_*): quais ponteiros o logger decodifica com -a
+#define SYSCALL_ARGS(a1, a2, a3, a4, a5, a6) \
+    (TRACE_ARG_##a1 | TRACE_ARG_##a2 << 4 | TRACE_ARG_##a3 << 8 | \
+     TRACE_ARG_##a4 << 12 | TRACE_ARG_##a5 << 16 | TRACE_ARG_##a6 << 20)
+#define SYSCALL_ARG_TYPE(types, i) (((types) >> (4 * (i))) & 0xf)
+unsigned int get_syscall_arg_types(long syscall_number);
 
 #endif
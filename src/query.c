@@ -0,0 +1,358 @@
+/**
+ * =====================================================================================
+ *
+ * Filename:  query.c
+ *
+ * Description:  Consultas ao log binário (modo -b do meu_logger) sem varrê-lo.
+ * O log é mapeado em memória e consultado pelo índice em syscall_log.bin.idx
+ * (ver trace_index.h), criado na primeira consulta e estendido nas seguintes
+ * enquanto o rastreamento continua: "todos os openat que falharam na thread
+ * 1234 entre 1,5 s e 2 s" lê só as posições dessas syscalls.
+ *
+ * Team:  Sérgio, Joel, Gustavo e Vinícius
+ * * =====================================================================================
+ */
+#include "parser.h"
+#include "repeat.h"
+#include "trace_format.h"
+#include "trace_index.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Condições da consulta; -1 / 0 / UINT64_MAX desligam cada uma
+static long want_nr = -1;
+static long want_tid = -1;
+static uint64_t from_ns = 0;
+static uint64_t to_ns = UINT64_MAX;
+static int only_failed = 0;
+static int count_only = 0;
+
+static struct trace_file_header hdr;
+static uint64_t matches = 0;
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Uso: %s [-s syscall] [-p tid] [-t INI:FIM] [-x] [-n] [-R] <syscall_log.bin>\n", prog);
+    fprintf(stderr, "Exemplo: %s -s openat -p 1234 -x -t 1500:2000 syscall_log.bin\n", prog);
+    fprintf(stderr, "  -s  Só a syscall (nome ou número)\n");
+    fprintf(stderr, "  -p  Só a thread (tid)\n");
+    fprintf(stderr, "  -t  Só as syscalls iniciadas entre INI e FIM ms desde o início do rastreamento\n");
+    fprintf(stderr, "  -x  Só as syscalls que falharam (retorno de -4095 a -1)\n");
+    fprintf(stderr, "  -n  Mostra só a quantidade de syscalls encontradas\n");
+    fprintf(stderr, "  -R  Refaz o índice do zero\n");
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/**
+ * @brief Número da syscall na arquitetura do log (nome ou número decimal).
+ */
+static long parse_syscall(const char *arg)
+{
+    char *end;
+    long nr = strtol(arg, &end, 10);
+
+    if (*arg != '\0' && *end == '\0' && nr >= 0)
+        return nr;
+    for (nr = 0; nr < SYSCALL_NR_MAX; nr++)
+    {
+        if (strcmp(get_syscall_name_arch(hdr.arch, nr), arg) == 0)
+            return nr;
+    }
+    return -1;
+}
+
+/**
+ * @brief Imprime a syscall se ela atende a todas as condições.
+ */
+static void match(const struct trace_record *rec, const void *payload)
+{
+    if ((want_nr != -1 && rec->nr != want_nr) || (want_tid != -1 && rec->tid != (uint64_t) want_tid))
+        return;
+    if (rec->ts_ns < from_ns || rec->ts_ns > to_ns)
+        return;
+    if (only_failed && !((rec->flags & TRACE_F_EXIT) && rec->ret < 0 && rec->ret >= -4095))
+        return;
+    matches++;
+    if (!count_only)
+        log_syscall_record(stdout, &hdr, rec, payload);
+}
+
+/**
+ * @brief Confere um registro do log; uma repetição (-z) é expandida.
+ */
+static void check(const struct trace_record *rec, const void *payload)
+{
+    if (rec->flags & TRACE_F_REPEAT)
+        repeat_expand(rec, payload, match);
+    else
+        match(rec, payload);
+}
+
+/**
+ * @brief Trecho do índice de tempo que contém o registro em off.
+ */
+static uint32_t chunk_of(const struct trace_index_segment *seg, uint64_t off)
+{
+    uint32_t lo = 0, hi = seg->hdr->chunks;
+
+    while (hi - lo > 1)
+    {
+        uint32_t mid = (lo + hi) / 2;
+        if (seg->chunks[mid].offset <= off)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief Primeira posição da lista list[0..n) que é >= off.
+ */
+static uint64_t lower_bound(const uint64_t *list, uint64_t n, uint64_t off)
+{
+    uint64_t lo = 0, hi = n;
+
+    while (lo < hi)
+    {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (list[mid] < off)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+static int chunk_in_range(const struct index_chunk *c)
+{
+    return c->max_ts >= from_ns && c->min_ts <= to_ns;
+}
+
+/**
+ * @brief Confere os registros de [off, end) do log, um a um.
+ */
+static void scan(const uint8_t *log, size_t size, uint64_t off, uint64_t end)
+{
+    const struct trace_record *rec;
+    const void *payload;
+
+    while (off < end && (rec = trace_log_next(log, size, &off, &payload)) != NULL)
+        check(rec, payload);
+}
+
+/**
+ * @brief Responde à consulta por um segmento do índice: listas de posições ou
+ * trechos de tempo.
+ */
+static void run_segment(const struct trace_index_segment *seg, const uint8_t *log, size_t size)
+{
+    const uint64_t *a = NULL, *b = NULL;
+    uint64_t na = 0, nb = 0;
+
+    if (want_nr != -1)
+        a = trace_index_find(seg, INDEX_BY_NR, want_nr, &na);
+    if (want_tid != -1)
+    {
+        b = trace_index_find(seg, INDEX_BY_TID, want_tid, &nb);
+        if (want_nr == -1)
+        {
+            a = b;
+            na = nb;
+            b = NULL;
+        }
+    }
+
+    if (want_nr == -1 && want_tid == -1)
+    {
+        // Sem syscall nem thread: só os trechos que cruzam o intervalo de tempo
+        for (uint32_t c = 0; c < seg->hdr->chunks; c++)
+        {
+            uint64_t end = c + 1 < seg->hdr->chunks ? seg->chunks[c + 1].offset : seg->hdr->log_end;
+            if (chunk_in_range(&seg->chunks[c]))
+                scan(log, size, seg->chunks[c].offset, end);
+        }
+        return;
+    }
+
+    // Interseção das duas listas (ambas em ordem crescente de posição)
+    for (uint64_t i = 0, j = 0; i < na; i++)
+    {
+        const struct trace_record *rec;
+        const void *payload;
+        uint64_t off = a[i];
+        uint32_t c;
+
+        if (b)
+        {
+            while (j < nb && b[j] < off)
+                j++;
+            if (j == nb)
+                break;
+            if (b[j] != off)
+                continue;
+        }
+        c = chunk_of(seg, off);
+        if (!chunk_in_range(&seg->chunks[c]))
+        {
+            // Pula de uma vez as posições do resto do trecho
+            if (c + 1 == seg->hdr->chunks)
+                break;
+            i = lower_bound(a, na, seg->chunks[c + 1].offset) - 1;
+            continue;
+        }
+        if ((rec = trace_log_next(log, size, &off, &payload)) != NULL)
+            check(rec, payload);
+    }
+}
+
+/**
+ * @brief Responde à consulta pelo índice, segmento a segmento (na ordem do log).
+ */
+static void run_indexed(const struct trace_index *ix, const uint8_t *log, size_t size)
+{
+    for (uint32_t s = 0; s < ix->hdr->segments; s++)
+        run_segment(&ix->segments[s], log, size);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *syscall_arg = NULL;
+    const char *path;
+    char idx_path[4096];
+    struct trace_index ix;
+    struct stat st;
+    const uint8_t *log;
+    uint64_t start;
+    long added;
+    int rebuild = 0;
+    int opt;
+    int fd;
+
+    while ((opt = getopt(argc, argv, "s:p:t:xnR")) != -1)
+    {
+        switch (opt)
+        {
+        case 's':
+            syscall_arg = optarg;
+            break;
+        case 'p':
+            want_tid = atol(optarg);
+            if (want_tid <= 0)
+            {
+                fprintf(stderr, "TID inválido: %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 't':
+        {
+            double from_ms, to_ms;
+            if (sscanf(optarg, "%lf:%lf", &from_ms, &to_ms) != 2 || from_ms < 0 || to_ms < from_ms)
+            {
+                fprintf(stderr, "Intervalo inválido: %s (use INI:FIM em ms, ex: 1500:2000)\n", optarg);
+                return 1;
+            }
+            from_ns = (uint64_t) (from_ms * 1e6);
+            to_ns = (uint64_t) (to_ms * 1e6);
+            break;
+        }
+        case 'x':
+            only_failed = 1;
+            break;
+        case 'n':
+            count_only = 1;
+            break;
+        case 'R':
+            rebuild = 1;
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (argc - optind != 1)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    path = argv[optind];
+    snprintf(idx_path, sizeof(idx_path), "%s.idx", path);
+
+    fd = open(path, O_RDONLY);
+    if (fd == -1)
+    {
+        perror("Erro ao abrir o log binário");
+        return 1;
+    }
+    if (fstat(fd, &st) == -1 || (size_t) st.st_size < sizeof(hdr))
+    {
+        fprintf(stderr, "%s: não é um log binário do meu_logger\n", path);
+        close(fd);
+        return 1;
+    }
+    log = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (log == MAP_FAILED)
+    {
+        perror("Erro ao mapear o log binário");
+        return 1;
+    }
+    memcpy(&hdr, log, sizeof(hdr));
+    if (memcmp(hdr.magic, TRACE_MAGIC, sizeof(hdr.magic)) != 0 || hdr.version < 2 || hdr.version > TRACE_VERSION ||
+        (hdr.arch != TRACE_ARCH_X86_64 && hdr.arch != TRACE_ARCH_AARCH64))
+    {
+        fprintf(stderr, "%s: não é um log binário do meu_logger (versão 2 a %d)\n", path, TRACE_VERSION);
+        munmap((void *) log, (size_t) st.st_size);
+        return 1;
+    }
+    if (syscall_arg && (want_nr = parse_syscall(syscall_arg)) == -1)
+    {
+        fprintf(stderr, "Syscall desconhecida: %s\n", syscall_arg);
+        munmap((void *) log, (size_t) st.st_size);
+        return 1;
+    }
+    // Os instantes do log são de CLOCK_MONOTONIC; -t é relativo ao início
+    from_ns += hdr.start_monotonic_ns;
+    to_ns = to_ns == UINT64_MAX ? to_ns : to_ns + hdr.start_monotonic_ns;
+
+    // Índice criado na primeira consulta; nas outras, só o trecho novo do log
+    start = now_ns();
+    added = trace_index_update(idx_path, log, (size_t) st.st_size, rebuild);
+    if (added > 0)
+        fprintf(stderr, "[*] Índice %s: %ld registros novos em %.3f ms\n", idx_path, added,
+                (double) (now_ns() - start) / 1e6);
+
+    start = now_ns();
+    if (added >= 0 && trace_index_open(&ix, idx_path, &hdr) == 0)
+    {
+        run_indexed(&ix, log, (size_t) st.st_size);
+        // O que foi gravado depois da atualização do índice
+        scan(log, (size_t) st.st_size, ix.hdr->indexed_size, (uint64_t) st.st_size);
+        trace_index_close(&ix);
+    }
+    else
+    {
+        // Sem permissão para gravar o índice (ou sem memória): varre o log
+        fprintf(stderr, "[*] Não foi possível gravar %s; varrendo o log inteiro.\n", idx_path);
+        scan(log, (size_t) st.st_size, sizeof(hdr), (uint64_t) st.st_size);
+    }
+
+    if (count_only)
+        printf("%llu\n", (unsigned long long) matches);
+    fprintf(stderr, "[*] %llu syscalls encontradas em %.3f ms\n", (unsigned long long) matches,
+            (double) (now_ns() - start) / 1e6);
+    munmap((void *) log, (size_t) st.st_size);
+    return 0;
+}
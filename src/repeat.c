@@ -0,0 +1,267 @@
+#include "repeat.h"
+#include "varint.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define REPEAT_WINDOW (2 * TRACE_REPEAT_PERIOD_MAX)
+
+// Espaço dos varints no payload, depois do cabeçalho e do primeiro ciclo
+#define REPEAT_VARINTS_MAX \
+    (TRACE_PAYLOAD_MAX - sizeof(struct trace_repeat) - (TRACE_REPEAT_PERIOD_MAX - 1) * sizeof(struct trace_record))
+// Pior caso de uma syscall: três varints de 64 bits
+#define REPEAT_EVENT_MAX (3 * VARINT_MAX)
+
+// Estado de uma thread. Fora de repetição (period == 0), window guarda os
+// held registros mais recentes, ainda não entregues; numa repetição,
+// window[0..period) é o primeiro ciclo e os varints guardam o resto.
+struct repeat_state {
+    uint32_t tid;       // 0: posição livre
+    int held;
+    int period;
+    uint32_t count;
+    uint64_t first_ts;  // Entrada da primeira syscall da repetição
+    uint64_t last_ts;   // Entrada da última (base da próxima diferença)
+    uint64_t last_end;  // Saída da última
+    size_t len;         // Bytes em varints
+    struct trace_record window[REPEAT_WINDOW];
+    uint8_t varints[REPEAT_VARINTS_MAX];
+};
+
+static struct repeat_state *states = NULL;
+static repeat_emit_fn emit_fn = NULL;
+static uint64_t events = 0;
+static uint64_t groups = 0;
+
+// Repetição sendo gravada: cabeçalho, primeiro ciclo e varints, em posições inteiras
+static struct trace_record out[1 + TRACE_PAYLOAD_MAX / sizeof(struct trace_record)];
+
+/**
+ * @brief Classe do retorno: 0 para sucesso, o próprio valor para um erro (-4095 a -1).
+ */
+static int64_t ret_class(int64_t ret) {
+    return ret < 0 && ret >= -4095 ? ret : 0;
+}
+
+static int same_call(const struct trace_record *a, const struct trace_record *b) {
+    return a->nr == b->nr && a->flags == b->flags && ret_class(a->ret) == ret_class(b->ret) &&
+           memcmp(a->args, b->args, sizeof(a->args)) == 0;
+}
+
+/**
+ * @brief Acrescenta uma syscall à repetição; tmpl é o registro da sua posição no ciclo.
+ */
+static void add_event(struct repeat_state *s, const struct trace_record *rec, const struct trace_record *tmpl) {
+    uint8_t *p = s->varints + s->len;
+
+    p = put_varint(p, zigzag((int64_t) (rec->ts_ns - s->last_ts)));
+    p = put_varint(p, rec->dur_ns);
+    p = put_varint(p, zigzag(rec->ret - tmpl->ret));
+    s->len = (size_t) (p - s->varints);
+    s->last_ts = rec->ts_ns;
+    s->last_end = rec->ts_ns + rec->dur_ns;
+    s->count++;
+}
+
+/**
+ * @brief Grava a repetição em curso como um registro com TRACE_F_REPEAT.
+ */
+static void emit_repeat(struct repeat_state *s) {
+    struct trace_repeat rep;
+    struct trace_record rec = s->window[0];
+    uint8_t *p = (uint8_t *) out;
+    size_t len;
+
+    rep.period = (uint32_t) s->period;
+    rep.count = s->count;
+    rep.span_ns = s->last_end - s->first_ts;
+    memcpy(p, &rep, sizeof(rep));
+    len = sizeof(rep);
+    memcpy(p + len, &s->window[1], (size_t) (s->period - 1) * sizeof(rec));
+    len += (size_t) (s->period - 1) * sizeof(rec);
+    memcpy(p + len, s->varints, s->len);
+    len += s->len;
+    memset(p + len, 0, TRACE_PAYLOAD_SLOTS(len) * sizeof(rec) - len);
+
+    rec.flags |= TRACE_F_REPEAT;
+    rec.payload = (uint32_t) len;
+    emit_fn(&rec, out);
+    events += s->count;
+    groups++;
+    s->period = 0;
+}
+
+/**
+ * @brief Entrega os n registros mais antigos da janela, como estão.
+ */
+static void emit_held(struct repeat_state *s, int n) {
+    for (int i = 0; i < n; i++) {
+        emit_fn(&s->window[i], NULL);
+    }
+    memmove(&s->window[0], &s->window[n], (size_t) (s->held - n) * sizeof(s->window[0]));
+    s->held -= n;
+}
+
+static void flush_state(struct repeat_state *s) {
+    if (s->period) {
+        emit_repeat(s);
+    } else {
+        emit_held(s, s->held);
+    }
+    s->tid = 0;
+}
+
+/**
+ * @brief Procura, no fim da janela, dois ciclos seguidos iguais (o menor primeiro).
+ *
+ * Os registros antes deles são entregues e a janela passa a ser o primeiro
+ * ciclo de uma repetição que já começa com duas voltas.
+ */
+static void detect(struct repeat_state *s) {
+    for (int period = 1; period <= TRACE_REPEAT_PERIOD_MAX && 2 * period <= s->held; period++) {
+        int base = s->held - 2 * period;
+        int k = 0;
+
+        while (k < period && same_call(&s->window[base + k], &s->window[base + period + k])) {
+            k++;
+        }
+        if (k < period) {
+            continue;
+        }
+        emit_held(s, base);
+        s->period = period;
+        s->count = (uint32_t) period;
+        s->first_ts = s->window[0].ts_ns;
+        s->last_ts = s->window[period - 1].ts_ns;
+        s->len = 0;
+        for (k = period; k < 2 * period; k++) {
+            add_event(s, &s->window[k], &s->window[k - period]);
+        }
+        s->held = 0;
+        return;
+    }
+}
+
+int repeat_init(repeat_emit_fn emit) {
+    states = calloc(REPEAT_THREADS, sizeof(*states));
+    if (!states) {
+        return -1;
+    }
+    emit_fn = emit;
+    return 0;
+}
+
+void repeat_push(const struct trace_record *rec) {
+    struct repeat_state *s = &states[rec->tid % REPEAT_THREADS];
+
+    if (s->tid != rec->tid) {
+        // Posição de outra thread: ela entrega o que tem e cede o lugar
+        if (s->tid != 0) {
+            flush_state(s);
+        }
+        s->tid = rec->tid;
+    }
+
+    if (s->period) {
+        const struct trace_record *tmpl = &s->window[s->count % (uint32_t) s->period];
+        if (same_call(tmpl, rec) && s->len + REPEAT_EVENT_MAX <= sizeof(s->varints)) {
+            add_event(s, rec, tmpl);
+            return;
+        }
+        emit_repeat(s);
+    }
+
+    s->window[s->held++] = *rec;
+    detect(s);
+    if (!s->period && s->held == REPEAT_WINDOW) {
+        emit_held(s, 1);
+    }
+}
+
+void repeat_flush_tid(uint32_t tid) {
+    struct repeat_state *s = &states[tid % REPEAT_THREADS];
+
+    if (s->tid == tid) {
+        flush_state(s);
+    }
+}
+
+void repeat_flush_older(uint64_t now_ns) {
+    for (int i = 0; i < REPEAT_THREADS; i++) {
+        struct repeat_state *s = &states[i];
+        uint64_t oldest;
+
+        if (s->tid == 0) {
+            continue;
+        }
+        oldest = s->period ? s->first_ts : s->window[0].ts_ns;
+        if (now_ns > oldest + REPEAT_MAX_AGE_NS) {
+            flush_state(s);
+        }
+    }
+}
+
+void repeat_finish(void) {
+    if (!states) {
+        return;
+    }
+    for (int i = 0; i < REPEAT_THREADS; i++) {
+        if (states[i].tid != 0) {
+            flush_state(&states[i]);
+        }
+    }
+    free(states);
+    states = NULL;
+}
+
+uint64_t repeat_events(void) {
+    return events;
+}
+
+uint64_t repeat_groups(void) {
+    return groups;
+}
+
+int repeat_expand(const struct trace_record *rec, const void *payload, repeat_emit_fn emit) {
+    struct trace_record cycle[TRACE_REPEAT_PERIOD_MAX];
+    struct trace_repeat rep;
+    const uint8_t *p = payload;
+    const uint8_t *end = p + rec->payload;
+    uint64_t ts;
+
+    if (rec->payload < sizeof(rep)) {
+        return -1;
+    }
+    memcpy(&rep, p, sizeof(rep));
+    p += sizeof(rep);
+    if (rep.period == 0 || rep.period > TRACE_REPEAT_PERIOD_MAX || rep.count < rep.period ||
+        (size_t) (end - p) < (rep.period - 1) * sizeof(*rec)) {
+        return -1;
+    }
+
+    // O primeiro ciclo vem inteiro
+    cycle[0] = *rec;
+    cycle[0].flags &= ~(uint32_t) TRACE_F_REPEAT;
+    cycle[0].payload = 0;
+    memcpy(&cycle[1], p, (rep.period - 1) * sizeof(*rec));
+    p += (rep.period - 1) * sizeof(*rec);
+    for (uint32_t i = 0; i < rep.period; i++) {
+        emit(&cycle[i], NULL);
+    }
+
+    ts = cycle[rep.period - 1].ts_ns;
+    for (uint32_t i = rep.period; i < rep.count; i++) {
+        struct trace_record r = cycle[i % rep.period];
+        uint64_t dts, dur, dret;
+
+        if (get_varint(&p, end, &dts) == -1 || get_varint(&p, end, &dur) == -1 ||
+            get_varint(&p, end, &dret) == -1) {
+            return -1;
+        }
+        ts += (uint64_t) unzigzag(dts);
+        r.ts_ns = ts;
+        r.dur_ns = dur;
+        r.ret += unzigzag(dret);
+        emit(&r, NULL);
+    }
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include <stdint.h>
+#include "trace_format.h"
+
+#ifndef REPEAT_H
+#define REPEAT_H
+
+// Compactação de repetições (modo -z), na thread de escrita: sequências de
+// syscalls iguais da mesma thread (a mesma syscall, ou um ciclo curto como
+// epoll_wait/read/write) viram um único registro com TRACE_F_REPEAT, que
+// guarda o primeiro ciclo, a contagem, o intervalo de tempo e, compactados em
+// varints, o instante, a duração e o retorno de cada syscall (ver struct
+// trace_repeat). Nada se perde: o decodificador expande a repetição de volta.
+//
+// Duas syscalls são iguais com o mesmo número, os mesmos argumentos e
+// retornos da mesma classe (sucesso, ou o mesmo erro): read() que devolve
+// 10 ou 20 bytes continua na repetição. Registros com argumentos
+// decodificados (-a, -y) não são compactados.
+//
+// A memória é limitada: cada thread guarda no máximo 2 * TRACE_REPEAT_PERIOD_MAX
+// registros ainda sem repetição e os varints de uma repetição (que é gravada
+// ao encher o payload). Há REPEAT_THREADS estados, escolhidos pelo tid: uma
+// thread nova entrega o que a anterior da mesma posição guardava. Uma
+// repetição vai para o log quando é interrompida ou quando tem mais de
+// REPEAT_MAX_AGE_NS, por isso o log fica ordenado dentro de cada thread, mas
+// não mais estritamente entre threads.
+
+#define REPEAT_THREADS 64
+#define REPEAT_MAX_AGE_NS 1000000000ULL
+
+// Recebe os registros prontos para o log (payload é NULL sem TRACE_F_PAYLOAD)
+typedef void (*repeat_emit_fn)(const struct trace_record *rec, const void *payload);
+
+// Compactador: emit recebe os registros avulsos e as repetições
+int repeat_init(repeat_emit_fn emit);
+// Registro sem payload da thread rec->tid
+void repeat_push(const struct trace_record *rec);
+// Entrega o que a thread tid tem guardado (antes de um registro com payload dela)
+void repeat_flush_tid(uint32_t tid);
+// Entrega o que começou mais de REPEAT_MAX_AGE_NS antes de now_ns (CLOCK_MONOTONIC)
+void repeat_flush_older(uint64_t now_ns);
+// Entrega tudo e libera o compactador (fim do rastreamento)
+void repeat_finish(void);
+
+// Syscalls que entraram em repetições e quantas repetições foram gravadas
+uint64_t repeat_events(void);
+uint64_t repeat_groups(void);
+
+// Decodificador: chama emit para cada syscall de uma repetição, em ordem.
+// Retorna -1 se o payload estiver corrompido (as syscalls até ali já foram entregues).
+int repeat_expand(const struct trace_record *rec, const void *payload, repeat_emit_fn emit);
+
+#endif
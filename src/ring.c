@@ -0,0 +1,132 @@
+#include "ring.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+/**
+ * @brief Dorme enquanto *addr valer val (ou até ser acordado).
+ */
+static void futex_wait(atomic_uint *addr, unsigned int val) {
+    syscall(SYS_futex, (unsigned int *) addr, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0);
+}
+
+static void futex_wake(atomic_uint *addr) {
+    syscall(SYS_futex, (unsigned int *) addr, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+int ring_init(struct ring *r, uint32_t capacity, int drop_when_full) {
+    uint32_t size = 1;
+
+    // Arredonda para potência de 2, para que o índice seja só uma máscara
+    while (size < capacity && size < (1U << 30)) {
+        size <<= 1;
+    }
+
+    memset(r, 0, sizeof(*r));
+    r->slots = calloc(size, sizeof(*r->slots));
+    if (!r->slots) {
+        return -1;
+    }
+    r->mask = size - 1;
+    r->drop_when_full = drop_when_full;
+    return 0;
+}
+
+void ring_destroy(struct ring *r) {
+    free(r->slots);
+    r->slots = NULL;
+}
+
+int ring_push(struct ring *r, const struct trace_record *rec, const void *payload, uint32_t payload_len) {
+    unsigned int head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+    unsigned int need = 1 + (unsigned int) TRACE_PAYLOAD_SLOTS(payload_len);
+    unsigned int until_wrap = r->mask + 1 - (head & r->mask);
+    unsigned int pad = need > until_wrap ? until_wrap : 0;
+
+    while (head + pad + need - tail > r->mask + 1) {
+        if (r->drop_when_full) {
+            r->dropped++;
+            return -1;
+        }
+        // Buffer cheio: espera o consumidor liberar espaço. O aviso é dado
+        // antes de reler o índice para não perder o futex_wake().
+        atomic_store(&r->producer_waiting, 1);
+        tail = atomic_load(&r->tail);
+        if (head + pad + need - tail > r->mask + 1) {
+            futex_wait(&r->tail, tail);
+        }
+        atomic_store(&r->producer_waiting, 0);
+        tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+    }
+
+    for (unsigned int i = 0; i < pad; i++) {
+        r->slots[(head + i) & r->mask].flags = TRACE_F_PAD;
+    }
+    head += pad;
+    if (head + need - tail > r->high_water) {
+        r->high_water = head + need - tail;
+    }
+    r->slots[head & r->mask] = *rec;
+    if (payload_len > 0) {
+        struct trace_record *dst = &r->slots[(head + 1) & r->mask];
+        memcpy(dst, payload, payload_len);
+        // Completa a última posição: o arquivo binário não leva restos de registros antigos
+        memset((char *) dst + payload_len, 0, (need - 1) * sizeof(*dst) - payload_len);
+    }
+    // Publicação seq_cst: precisa ser ordenada com a leitura de consumer_waiting
+    // logo abaixo (o consumidor faz o par simétrico antes de dormir).
+    atomic_store(&r->head, head + need);
+
+    // Caminho comum: o consumidor está ocupado e ninguém precisa ser acordado
+    if (atomic_load(&r->consumer_waiting)) {
+        futex_wake(&r->head);
+    }
+    return 0;
+}
+
+void ring_close(struct ring *r) {
+    atomic_store(&r->closing, 1);
+    futex_wake(&r->head);
+}
+
+size_t ring_peek(struct ring *r, const struct trace_record **recs) {
+    unsigned int tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&r->head, memory_order_acquire);
+    size_t n, until_wrap;
+
+    while (head == tail) {
+        if (atomic_load(&r->closing)) {
+            // Relê o índice: o produtor pode ter publicado antes de fechar
+            head = atomic_load_explicit(&r->head, memory_order_acquire);
+            if (head == tail) {
+                return 0;
+            }
+            break;
+        }
+        atomic_store(&r->consumer_waiting, 1);
+        head = atomic_load(&r->head);
+        if (head == tail && !atomic_load(&r->closing)) {
+            futex_wait(&r->head, head);
+        }
+        atomic_store(&r->consumer_waiting, 0);
+        head = atomic_load_explicit(&r->head, memory_order_acquire);
+    }
+
+    // Entrega só o trecho contíguo; o resto vem na próxima chamada
+    n = head - tail;
+    until_wrap = (size_t) r->mask + 1 - (tail & r->mask);
+    *recs = &r->slots[tail & r->mask];
+    return n < until_wrap ? n : until_wrap;
+}
+
+void ring_release(struct ring *r, size_t n) {
+    unsigned int tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+
+    atomic_store(&r->tail, tail + (unsigned int) n);
+    if (atomic_load(&r->producer_waiting)) {
+        futex_wake(&r->tail);
+    }
+}
@@ -0,0 +1,45 @@
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "trace_format.h"
+
+#ifndef RING_H
+#define RING_H
+
+// Capacidade padrão do buffer circular, em registros (ajustável com -r)
+#define RING_DEFAULT_CAPACITY 65536
+
+// Buffer circular lock-free de um produtor (loop do ptrace) e um consumidor
+// (thread de escrita). Os índices crescem livremente e são mascarados na
+// hora do acesso; cada lado só escreve no seu próprio índice. Os campos de
+// cada lado ficam em linhas de cache separadas para evitar falso compartilhamento.
+struct ring {
+    _Alignas(64) atomic_uint head;         // Próxima posição a escrever (produtor)
+    atomic_uint consumer_waiting;          // Consumidor dormindo à espera de dados
+    uint64_t dropped;                      // Registros descartados (só o produtor escreve)
+    uint32_t high_water;                   // Maior ocupação vista pelo produtor
+    _Alignas(64) atomic_uint tail;         // Próxima posição a ler (consumidor)
+    atomic_uint producer_waiting;          // Produtor dormindo à espera de espaço
+    _Alignas(64) struct trace_record *slots;
+    uint32_t mask;
+    int drop_when_full;                    // 1: descarta e conta; 0: bloqueia o produtor
+    atomic_int closing;                    // Produtor terminou; consumidor esvazia e sai
+};
+
+int ring_init(struct ring *r, uint32_t capacity, int drop_when_full);
+void ring_destroy(struct ring *r);
+
+// Lado do produtor. Retorna 0 se o registro entrou ou -1 se foi descartado.
+// Com payload_len > 0, o payload ocupa as posições seguintes ao registro
+// (TRACE_PAYLOAD_SLOTS) e o conjunto nunca é dividido na volta do buffer:
+// as posições que sobram até o fim são marcadas com TRACE_F_PAD.
+int ring_push(struct ring *r, const struct trace_record *rec, const void *payload, uint32_t payload_len);
+void ring_close(struct ring *r);
+
+// Lado do consumidor: ring_peek() devolve quantas posições contíguas estão
+// disponíveis a partir de *recs (bloqueando até haver algum, ou 0 se o buffer
+// foi fechado e está vazio); ring_release() libera os n primeiros.
+size_t ring_peek(struct ring *r, const struct trace_record **recs);
+void ring_release(struct ring *r, size_t n);
+
+#endif
@@ -0,0 +1,116 @@
+#include "sampling.h"
+#include "output.h"
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+static unsigned int sample_every = 1;
+static unsigned int duty_on_ms = 0;
+static unsigned int duty_period_ms = 0;
+
+static int phase_on = 1;
+static uint64_t start_ns = 0;        // Início do rastreamento
+static uint64_t phase_start_ns = 0;  // Início da fase atual
+static uint64_t on_total_ns = 0;     // Soma das fases ativas já encerradas
+
+/**
+ * @brief Agenda o próximo SIGALRM para daqui a ms milissegundos.
+ */
+static void arm_timer(unsigned int ms) {
+    struct itimerval it = { { 0, 0 }, { ms / 1000, (ms % 1000) * 1000 } };
+    setitimer(ITIMER_REAL, &it, NULL);
+}
+
+void sampling_init(unsigned int every_n, unsigned int on_ms, unsigned int period_ms) {
+    sample_every = every_n > 1 ? every_n : 1;
+    duty_on_ms = on_ms;
+    duty_period_ms = period_ms;
+    start_ns = phase_start_ns = monotonic_ns();
+    phase_on = 1;
+    if (duty_period_ms > 0) {
+        arm_timer(duty_on_ms);
+    }
+}
+
+int sampling_active(void) {
+    return phase_on;
+}
+
+int sampling_take(struct tracee *t) {
+    return sample_every == 1 || (t->sample_seq++ % sample_every) == 0;
+}
+
+void sampling_toggle(int wake) {
+    uint64_t now = monotonic_ns();
+
+    if (duty_period_ms == 0) {
+        return;
+    }
+
+    if (phase_on) {
+        // Fim da fase ativa: cada thread recebe PTRACE_CONT na próxima parada
+        on_total_ns += now - phase_start_ns;
+        phase_on = 0;
+        arm_timer(duty_period_ms - duty_on_ms);
+    } else {
+        phase_on = 1;
+        arm_timer(duty_on_ms);
+        if (wake) {
+            int n = tracee_count();
+            pid_t *tids = malloc(sizeof(pid_t) * (n > 0 ? n : 1));
+            if (tids) {
+                n = tracee_tids(tids, n);
+                for (int i = 0; i < n; i++) {
+                    struct tracee *t = tracee_find(tids[i]);
+                    t->wake_pending = 1;
+                    syscall(SYS_tgkill, tracee_tgid(t), t->tid, SIGSTOP);
+                }
+                free(tids);
+            }
+        }
+    }
+    phase_start_ns = now;
+}
+
+/**
+ * @brief Tempo total em fase ativa até agora, incluindo a fase atual.
+ */
+static uint64_t on_time_ns(uint64_t now) {
+    return on_total_ns + (phase_on ? now - phase_start_ns : 0);
+}
+
+double sampling_scale(void) {
+    uint64_t now = monotonic_ns();
+    uint64_t on = on_time_ns(now);
+    double scale = (double) sample_every;
+
+    if (duty_period_ms > 0 && on > 0) {
+        scale *= (double) (now - start_ns) / (double) on;
+    }
+    return scale;
+}
+
+void sampling_report(FILE *out, uint64_t stops) {
+    uint64_t now = monotonic_ns();
+    double wall = (double) (now - start_ns) / 1e9;
+    struct rusage self;
+    double cpu;
+
+    getrusage(RUSAGE_SELF, &self);
+    cpu = (double) self.ru_utime.tv_sec + (double) self.ru_utime.tv_usec / 1e6 +
+          (double) self.ru_stime.tv_sec + (double) self.ru_stime.tv_usec / 1e6;
+
+    fprintf(out, "[*] Amostragem: 1 em %u syscalls", sample_every);
+    if (duty_period_ms > 0) {
+        fprintf(out, ", %u ms a cada %u ms (%.1f%% do tempo rastreado)", duty_on_ms, duty_period_ms,
+                wall > 0 ? 100.0 * (double) on_time_ns(now) / 1e9 / wall : 0.0);
+    }
+    fprintf(out, "\n");
+    fprintf(out, "[*] Custo: %llu paradas do ptrace (%.0f/s), CPU do logger %.3f s (%.1f%% de %.3f s)\n",
+            (unsigned long long) stops, wall > 0 ? (double) stops / wall : 0.0,
+            cpu, wall > 0 ? 100.0 * cpu / wall : 0.0, wall);
+    fprintf(out, "[*] Fator de estimativa dos totais: x%.2f\n", sampling_scale());
+}
@@ -0,0 +1,36 @@
+#include <stdio.h>
+#include <stdint.h>
+#include "tracee_table.h"
+
+#ifndef SAMPLING_H
+#define SAMPLING_H
+
+// Amostragem para limitar o custo do rastreamento em serviços sensíveis a latência.
+//  - 1 em N (-s N): só uma a cada N syscalls de cada thread é registrada.
+//  - Ciclo de trabalho (-w ON/PERIODO, em ms): rastreia durante ON ms a cada
+//    PERIODO ms; no resto do tempo as threads rodam com PTRACE_CONT, sem paradas.
+// Sem nenhuma das opções, todas as syscalls são registradas.
+
+// every_n == 0 ou 1 desliga o 1 em N; period_ms == 0 desliga o ciclo de trabalho.
+// Arma o primeiro SIGALRM; o loop principal chama sampling_toggle() a cada um.
+void sampling_init(unsigned int every_n, unsigned int on_ms, unsigned int period_ms);
+
+// 1 durante a fase de rastreamento do ciclo (sempre 1 sem -w)
+int sampling_active(void);
+
+// Decide se a syscall que está começando na thread t entra na amostra
+int sampling_take(struct tracee *t);
+
+// Troca de fase (chamada pelo loop principal depois de um SIGALRM). Ao voltar
+// para a fase ativa, para cada thread com SIGSTOP (marcando wake_pending) para
+// que ela possa ser retomada com PTRACE_SYSCALL. wake: 0 se as threads já param
+// sozinhas (modo filtrado, com seccomp).
+void sampling_toggle(int wake);
+
+// Fator para estimar os totais reais a partir do que foi amostrado
+double sampling_scale(void);
+
+// Imprime a fração do tempo rastreada e o custo real do rastreamento
+void sampling_report(FILE *out, uint64_t stops);
+
+#endif
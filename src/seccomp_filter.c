@@ -0,0 +1,100 @@
+#include "seccomp_filter.h"
+#include "parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <sys/prctl.h>
+#include <linux/audit.h>
+#include <linux/filter.h>
+#include <linux/seccomp.h>
+
+#if defined(__x86_64__)
+    #define SECCOMP_AUDIT_ARCH AUDIT_ARCH_X86_64
+#elif defined(__aarch64__)
+    #define SECCOMP_AUDIT_ARCH AUDIT_ARCH_AARCH64
+#else
+    #error "Arquitetura não suportada."
+#endif
+
+int seccomp_filter_parse(const char *lista, int *numeros, int max) {
+    char *copia = strdup(lista);
+    char *resto = copia;
+    char *nome;
+    int n = 0;
+
+    if (!copia) {
+        return -1;
+    }
+
+    while ((nome = strsep(&resto, ",")) != NULL) {
+        char *fim;
+        long numero;
+
+        if (*nome == '\0') {
+            continue; // Ignora vírgulas repetidas ("openat,,read")
+        }
+
+        // Aceita tanto o nome ("openat") quanto o número ("257")
+        numero = strtol(nome, &fim, 10);
+        if (*fim != '\0') {
+            numero = get_syscall_number(nome);
+        }
+
+        if (numero < 0 || numero >= SYSCALL_NR_MAX) {
+            fprintf(stderr, "Syscall desconhecida no filtro: %s\n", nome);
+            free(copia);
+            return -1;
+        }
+        if (n == max) {
+            fprintf(stderr, "Filtro com syscalls demais (máximo %d)\n", max);
+            free(copia);
+            return -1;
+        }
+        numeros[n++] = (int) numero;
+    }
+
+    free(copia);
+    if (n == 0) {
+        fprintf(stderr, "Lista de syscalls vazia: \"%s\"\n", lista);
+        return -1;
+    }
+    return n;
+}
+
+int seccomp_filter_install(const int *numeros, int n) {
+    // Programa: confere a arquitetura, carrega o número da syscall e compara
+    // com cada número selecionado. Cada comparação é seguida de um RET_TRACE,
+    // então os saltos são sempre curtos (não esbarram no limite de 8 bits do BPF).
+    int tamanho = 4 + 2 * n + 1;
+    struct sock_filter *prog = calloc(tamanho, sizeof(*prog));
+    struct sock_fprog fprog;
+    int i = 0;
+    int ret;
+
+    if (!prog) {
+        return -1;
+    }
+
+    prog[i++] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(struct seccomp_data, arch));
+    prog[i++] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, SECCOMP_AUDIT_ARCH, 1, 0);
+    prog[i++] = (struct sock_filter) BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW);
+    prog[i++] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(struct seccomp_data, nr));
+    for (int k = 0; k < n; k++) {
+        prog[i++] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, numeros[k], 0, 1);
+        prog[i++] = (struct sock_filter) BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_TRACE);
+    }
+    prog[i++] = (struct sock_filter) BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW);
+
+    fprog.len = (unsigned short) i;
+    fprog.filter = prog;
+
+    // Sem NO_NEW_PRIVS o kernel exige CAP_SYS_ADMIN para instalar o filtro.
+    ret = prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0);
+    if (ret == 0) {
+        ret = prctl(PR_SET_SECCOMP, SECCOMP_MODE_FILTER, &fprog, 0, 0);
+    }
+
+    free(prog);
+    return ret;
+}
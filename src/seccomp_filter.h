@@ -0,0 +1,19 @@
+#include <stdio.h>
+
+#ifndef SECCOMP_FILTER_H
+#define SECCOMP_FILTER_H
+
+// Quantidade máxima de syscalls que podem ser selecionadas com -f
+#define SECCOMP_FILTER_MAX 512
+
+// Converte uma lista "openat,connect,execve" (nomes ou números) em números de syscall.
+// Retorna a quantidade de syscalls lidas ou -1 em caso de erro (a mensagem já é
+// impressa), inclusive com a lista vazia.
+int seccomp_filter_parse(const char *lista, int *numeros, int max);
+
+// Instala no processo atual um filtro seccomp-BPF que devolve SECCOMP_RET_TRACE
+// para as syscalls selecionadas e SECCOMP_RET_ALLOW para todas as outras.
+// Deve ser chamada pelo filho, depois do PTRACE_TRACEME e antes do execvp().
+int seccomp_filter_install(const int *numeros, int n);
+
+#endif
@@ -0,0 +1,56 @@
+#include "selfstats.h"
+#include "output.h"
+
+struct selfstats_phase_counter selfstats_phases[SELF_PHASES];
+
+static uint64_t stops = 0;
+static _Atomic uint64_t bytes_written = 0;
+static uint64_t start_ns = 0;
+
+static const char *phase_names[SELF_PHASES] = {
+    "waitpid", "leitura", "registro", "retomada", "formato", "escrita"
+};
+
+void selfstats_stop(void) {
+    stops++;
+}
+
+uint64_t selfstats_stops(void) {
+    return stops;
+}
+
+void selfstats_bytes(uint64_t n) {
+    atomic_store_explicit(&bytes_written, atomic_load_explicit(&bytes_written, memory_order_relaxed) + n,
+                          memory_order_relaxed);
+}
+
+void selfstats_start(void) {
+    start_ns = monotonic_ns();
+}
+
+void selfstats_print(FILE *out) {
+    double wall = (double) (monotonic_ns() - start_ns) / 1e9;
+    uint64_t events = atomic_load_explicit(&selfstats_phases[SELF_RECORD].count, memory_order_relaxed);
+    uint64_t bytes = atomic_load_explicit(&bytes_written, memory_order_relaxed);
+
+    fprintf(out, "\n--- Contadores internos do logger (%.3f s) ---\n", wall);
+    fprintf(out, "Paradas do ptrace: %llu (%.0f/s)   Eventos registrados: %llu (%.0f/s)\n",
+            (unsigned long long) stops, wall > 0 ? (double) stops / wall : 0.0,
+            (unsigned long long) events, wall > 0 ? (double) events / wall : 0.0);
+    fprintf(out, "Bytes gravados: %llu", (unsigned long long) bytes);
+    if (events > 0 && bytes > 0) {
+        fprintf(out, " (%.1f por evento)", (double) bytes / (double) events);
+    }
+    fprintf(out, "   Ocupação máxima do buffer: %u registros\n", output_ring_high_water());
+
+    fprintf(out, "%-11s %12s %12s %11s %8s\n", "fase", "vezes", "segundos", "ns/vez", "% tempo");
+    for (int i = 0; i < SELF_PHASES; i++) {
+        uint64_t count = atomic_load_explicit(&selfstats_phases[i].count, memory_order_relaxed);
+        uint64_t ns = atomic_load_explicit(&selfstats_phases[i].ns, memory_order_relaxed);
+        if (count == 0) {
+            continue;
+        }
+        fprintf(out, "%-11s %12llu %12.6f %11.1f %8.2f\n", phase_names[i], (unsigned long long) count,
+                (double) ns / 1e9, (double) ns / (double) count, wall > 0 ? 100.0 * (double) ns / 1e9 / wall : 0.0);
+    }
+}
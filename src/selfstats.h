@@ -0,0 +1,51 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#ifndef SELFSTATS_H
+#define SELFSTATS_H
+
+// Contadores internos do próprio logger, para saber onde vai o tempo do
+// rastreamento. Cada fase tem um único escritor (o loop do ptrace ou a thread
+// de escrita), então basta um load + store relaxado: nada de instruções com
+// lock no caminho crítico. O custo é de duas leituras de CLOCK_MONOTONIC (vDSO,
+// sem syscall) por fase, bem abaixo do custo de uma parada do ptrace.
+enum selfstats_phase {
+    SELF_WAIT,     // Loop: dentro do waitpid(), esperando a próxima parada
+    SELF_READ,     // Loop: leitura da parada (PTRACE_GET_SYSCALL_INFO ou registradores)
+    SELF_RECORD,   // Loop: entrega do registro ao buffer circular ou aos contadores (-c)
+    SELF_RESUME,   // Loop: PTRACE_SYSCALL / PTRACE_CONT
+    SELF_FORMAT,   // Escrita: formatação do texto (inclui a busca do nome da syscall)
+    SELF_WRITE,    // Escrita: gravação do lote pelo backend (write, cópia para o mapeamento ou io_uring)
+    SELF_PHASES
+};
+
+struct selfstats_phase_counter {
+    _Atomic uint64_t count;
+    _Atomic uint64_t ns;
+};
+
+extern struct selfstats_phase_counter selfstats_phases[SELF_PHASES];
+
+static inline void selfstats_add(enum selfstats_phase p, uint64_t count, uint64_t ns) {
+    struct selfstats_phase_counter *c = &selfstats_phases[p];
+    atomic_store_explicit(&c->count, atomic_load_explicit(&c->count, memory_order_relaxed) + count,
+                          memory_order_relaxed);
+    atomic_store_explicit(&c->ns, atomic_load_explicit(&c->ns, memory_order_relaxed) + ns,
+                          memory_order_relaxed);
+}
+
+// Paradas do ptrace atendidas pelo loop (só o loop escreve)
+void selfstats_stop(void);
+uint64_t selfstats_stops(void);
+
+// Bytes gravados no arquivo de log (só a thread de escrita escreve)
+void selfstats_bytes(uint64_t n);
+
+// Marca o início da medição (chamado antes do loop principal)
+void selfstats_start(void);
+
+// Imprime os contadores. Pode ser chamada durante o rastreamento (SIGUSR1).
+void selfstats_print(FILE *out);
+
+#endif
@@ -0,0 +1,174 @@
+#include "stats.h"
+#include "parser.h"
+#include <stdlib.h>
+
+// Tabela densa indexada pelo número da syscall; a última posição acumula
+// os números fora das tabelas de nomes.
+static struct syscall_stats table[SYSCALL_NR_MAX + 1];
+
+// Histogramas por syscall, alocados no primeiro uso (no máximo um por número)
+static struct histogram *latency[SYSCALL_NR_MAX + 1];
+
+// Histogramas por processo. A última posição é o grupo "outros".
+struct group_stats {
+    pid_t tgid;
+    struct histogram latency;
+};
+static struct group_stats groups[STATS_MAX_GROUPS + 1];
+static int group_count = 0;
+
+/**
+ * @brief Encontra (ou cria) o grupo do processo tgid.
+ */
+static struct group_stats *group_of(pid_t tgid) {
+    // Busca linear, mas só entre os processos rastreados (em geral poucos)
+    // e com o último grupo usado verificado primeiro.
+    static int last = 0;
+
+    if (group_count > 0 && groups[last].tgid == tgid) {
+        return &groups[last];
+    }
+    for (int i = 0; i < group_count; i++) {
+        if (groups[i].tgid == tgid) {
+            last = i;
+            return &groups[i];
+        }
+    }
+    if (group_count == STATS_MAX_GROUPS) {
+        return &groups[STATS_MAX_GROUPS];
+    }
+    groups[group_count].tgid = tgid;
+    last = group_count;
+    return &groups[group_count++];
+}
+
+void stats_record(const struct trace_record *rec, pid_t tgid) {
+    unsigned int nr = (unsigned int) rec->nr;
+    unsigned int i = nr < SYSCALL_NR_MAX ? nr : SYSCALL_NR_MAX;
+    struct syscall_stats *s = &table[i];
+
+    s->calls++;
+    if (rec->flags & TRACE_F_EXIT) {
+        s->completed++;
+        s->total_ns += rec->dur_ns;
+        if (rec->ret < 0 && rec->ret >= -4095) {
+            s->errors++;
+        }
+
+        if (!latency[i]) {
+            latency[i] = calloc(1, sizeof(struct histogram));
+            if (!latency[i]) {
+                return; // Sem memória: fica só com os contadores
+            }
+        }
+        hist_record(latency[i], rec->dur_ns);
+        hist_record(&group_of(tgid)->latency, rec->dur_ns);
+    }
+}
+
+/**
+ * @brief Ordena os índices por tempo total decrescente (e por chamadas, no empate).
+ */
+static int compare_by_time(const void *a, const void *b) {
+    const struct syscall_stats *x = &table[*(const int *) a];
+    const struct syscall_stats *y = &table[*(const int *) b];
+
+    if (x->total_ns != y->total_ns) {
+        return x->total_ns < y->total_ns ? 1 : -1;
+    }
+    if (x->calls != y->calls) {
+        return x->calls < y->calls ? 1 : -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Imprime uma linha de percentis (em microssegundos).
+ */
+static void print_percentiles(FILE *out, const struct histogram *h, const char *label) {
+    fprintf(out, "%10.3f %10.3f %10.3f %10.3f %10.3f %10llu %s\n",
+            (double) hist_percentile(h, 50.0) / 1e3,
+            (double) hist_percentile(h, 90.0) / 1e3,
+            (double) hist_percentile(h, 99.0) / 1e3,
+            (double) hist_percentile(h, 99.9) / 1e3,
+            (double) h->max / 1e3,
+            (unsigned long long) h->count, label);
+}
+
+/**
+ * @brief Imprime os percentis de latência por syscall (na ordem da tabela) e por processo.
+ */
+static void print_latency(FILE *out, const int *order, int n) {
+    struct histogram *all = calloc(1, sizeof(*all));
+    char label[32];
+
+    fprintf(out, "\nLatência (us)\n");
+    fprintf(out, "       p50        p90        p99      p99.9        max   amostras syscall\n");
+    fprintf(out, "---------- ---------- ---------- ---------- ---------- ---------- ----------------\n");
+    for (int i = 0; i < n; i++) {
+        const struct histogram *h = latency[order[i]];
+        if (h && h->count > 0) {
+            print_percentiles(out, h, order[i] < SYSCALL_NR_MAX ? get_syscall_name(order[i]) : "unknown_syscall");
+            if (all) {
+                hist_merge(all, h);
+            }
+        }
+    }
+    if (all) {
+        fprintf(out, "---------- ---------- ---------- ---------- ---------- ---------- ----------------\n");
+        print_percentiles(out, all, "total");
+        free(all);
+    }
+
+    fprintf(out, "\n       p50        p90        p99      p99.9        max   amostras processo\n");
+    fprintf(out, "---------- ---------- ---------- ---------- ---------- ---------- ----------------\n");
+    for (int i = 0; i < group_count; i++) {
+        snprintf(label, sizeof(label), "PID %d", (int) groups[i].tgid);
+        print_percentiles(out, &groups[i].latency, label);
+    }
+    if (groups[STATS_MAX_GROUPS].latency.count > 0) {
+        print_percentiles(out, &groups[STATS_MAX_GROUPS].latency, "outros");
+    }
+}
+
+void stats_print(FILE *out, double scale) {
+    int order[SYSCALL_NR_MAX + 1];
+    int n = 0;
+    uint64_t total_ns = 0, total_calls = 0, total_completed = 0, total_errors = 0;
+
+    for (int nr = 0; nr <= SYSCALL_NR_MAX; nr++) {
+        if (table[nr].calls > 0) {
+            order[n++] = nr;
+            total_ns += table[nr].total_ns;
+            total_calls += table[nr].calls;
+            total_completed += table[nr].completed;
+            total_errors += table[nr].errors;
+        }
+    }
+    qsort(order, n, sizeof(order[0]), compare_by_time);
+
+    if (scale != 1.0) {
+        fprintf(out, "Valores estimados: contagens e tempos amostrados multiplicados por %.2f\n", scale);
+    }
+    fprintf(out, "%% tempo     segundos  us/chamada   chamadas     erros syscall\n");
+    fprintf(out, "------- ------------ ----------- ---------- --------- ----------------\n");
+    for (int i = 0; i < n; i++) {
+        const struct syscall_stats *s = &table[order[i]];
+        fprintf(out, "%7.2f %12.6f %11.3f %10llu %9llu %s\n",
+                total_ns ? 100.0 * (double) s->total_ns / (double) total_ns : 0.0,
+                (double) s->total_ns / 1e9 * scale,
+                // Média só das que retornaram: as outras não têm duração
+                s->completed ? (double) s->total_ns / 1e3 / (double) s->completed : 0.0,
+                (unsigned long long) ((double) s->calls * scale + 0.5),
+                (unsigned long long) ((double) s->errors * scale + 0.5),
+                order[i] < SYSCALL_NR_MAX ? get_syscall_name(order[i]) : "unknown_syscall");
+    }
+    fprintf(out, "------- ------------ ----------- ---------- --------- ----------------\n");
+    fprintf(out, "%7.2f %12.6f %11.3f %10llu %9llu total\n",
+            100.0, (double) total_ns / 1e9 * scale,
+            total_completed ? (double) total_ns / 1e3 / (double) total_completed : 0.0,
+            (unsigned long long) ((double) total_calls * scale + 0.5),
+            (unsigned long long) ((double) total_errors * scale + 0.5));
+
+    print_latency(out, order, n);
+}
@@ -0,0 +1,31 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include "trace_format.h"
+#include "histogram.h"
+
+#ifndef STATS_H
+#define STATS_H
+
+// Contadores agregados de uma syscall (modo resumo, -c)
+struct syscall_stats {
+    uint64_t calls;
+    uint64_t completed; // Chamadas que retornaram (sem exit_group, threads soltas...)
+    uint64_t errors;    // Retornos entre -4095 e -1 (errno)
+    uint64_t total_ns;  // Soma das durações das chamadas que retornaram
+};
+
+// Quantidade de processos (grupos de threads) com histograma próprio;
+// os excedentes são somados num grupo "outros".
+#define STATS_MAX_GROUPS 64
+
+// Atualiza os contadores e os histogramas de latência (por syscall e pelo
+// processo tgid) com uma syscall terminada. Sem nenhuma E/S.
+void stats_record(const struct trace_record *rec, pid_t tgid);
+
+// Imprime a tabela de resumo, ordenada pelo tempo total, seguida dos
+// percentis de latência. Pode ser chamada durante o rastreamento.
+// scale multiplica contagens e tempos totais (estimativa com amostragem; 1 sem).
+void stats_print(FILE *out, double scale);
+
+#endif
@@ -0,0 +1,102 @@
+#include "syscall_info.h"
+#include <errno.h>
+#include <string.h>
+#include <sys/ptrace.h>
+#include <sys/user.h>   // Obrigatório para a struct user_regs_struct
+#include <sys/uio.h>    // Obrigatório para a struct iovec
+#include <linux/elf.h>  // Obrigatório para a constante NT_PRSTATUS
+
+#ifndef PTRACE_GET_SYSCALL_INFO
+#define PTRACE_GET_SYSCALL_INFO 0x420e
+#endif
+
+// Cópia do layout de struct ptrace_syscall_info (linux/ptrace.h), para não
+// depender da versão dos cabeçalhos do kernel/glibc instalados.
+struct raw_syscall_info {
+    uint8_t op;
+    uint8_t pad[3];
+    uint32_t arch;
+    uint64_t instruction_pointer;
+    uint64_t stack_pointer;
+    union {
+        struct {
+            uint64_t nr;
+            uint64_t args[6];
+        } entry;
+        struct {
+            int64_t rval;
+            uint8_t is_error;
+        } exit;
+        struct {
+            uint64_t nr;
+            uint64_t args[6];
+            uint32_t ret_data;
+        } seccomp;
+    };
+};
+
+// 1 enquanto PTRACE_GET_SYSCALL_INFO funcionar; vira 0 no primeiro EIO
+static int have_syscall_info = 1;
+
+/**
+ * @brief Caminho antigo: lê o conjunto completo de registradores.
+ */
+static int read_from_regs(pid_t tid, int expected_op, struct syscall_stop *st) {
+    struct user_regs_struct regs;
+
+    #if defined(__x86_64__)
+        if (ptrace(PTRACE_GETREGS, tid, NULL, &regs) == -1)
+            return -1;
+        st->nr = (int32_t) regs.orig_rax;
+        st->args[0] = regs.rdi;
+        st->args[1] = regs.rsi;
+        st->args[2] = regs.rdx;
+        st->args[3] = regs.r10;
+        st->args[4] = regs.r8;
+        st->args[5] = regs.r9;
+        st->ret = (int64_t) regs.rax;
+    #elif defined(__aarch64__)
+        struct iovec iov = { .iov_base = &regs, .iov_len = sizeof(regs) };
+        if (ptrace(PTRACE_GETREGSET, tid, NT_PRSTATUS, &iov) == -1)
+            return -1;
+        st->nr = (int32_t) regs.regs[8];
+        for (int i = 0; i < 6; i++)
+            st->args[i] = regs.regs[i];
+        st->ret = (int64_t) regs.regs[0];
+    #else
+        #error "Arquitetura não suportada."
+    #endif
+
+    st->op = expected_op;
+    return 0;
+}
+
+int syscall_stop_read(pid_t tid, int expected_op, struct syscall_stop *st) {
+    struct raw_syscall_info info;
+
+    if (have_syscall_info) {
+        if (ptrace(PTRACE_GET_SYSCALL_INFO, tid, (void *) sizeof(info), &info) > 0) {
+            st->op = info.op;
+            switch (info.op) {
+            case SYSCALL_STOP_ENTRY:
+                st->nr = (int32_t) info.entry.nr;
+                memcpy(st->args, info.entry.args, sizeof(st->args));
+                break;
+            case SYSCALL_STOP_SECCOMP:
+                st->nr = (int32_t) info.seccomp.nr;
+                memcpy(st->args, info.seccomp.args, sizeof(st->args));
+                break;
+            case SYSCALL_STOP_EXIT:
+                st->ret = info.exit.rval;
+                break;
+            }
+            return 0;
+        }
+        if (errno != EIO) {
+            return -1; // A thread sumiu (ESRCH) ou não está parada
+        }
+        have_syscall_info = 0; // Kernel sem suporte: usa os registradores daqui em diante
+    }
+
+    return read_from_regs(tid, expected_op, st);
+}
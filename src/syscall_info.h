@@ -0,0 +1,28 @@
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifndef SYSCALL_INFO_H
+#define SYSCALL_INFO_H
+
+// Tipo de parada de syscall (mesmos valores de PTRACE_SYSCALL_INFO_*)
+#define SYSCALL_STOP_NONE    0
+#define SYSCALL_STOP_ENTRY   1
+#define SYSCALL_STOP_EXIT    2
+#define SYSCALL_STOP_SECCOMP 3
+
+// O que interessa ao logger numa parada de syscall
+struct syscall_stop {
+    int op;           // SYSCALL_STOP_*
+    int32_t nr;       // Entrada/seccomp
+    uint64_t args[6]; // Entrada/seccomp
+    int64_t ret;      // Saída
+};
+
+// Lê a parada atual da thread tid. Usa PTRACE_GET_SYSCALL_INFO (Linux >= 5.3),
+// que copia só número, argumentos e retorno e informa explicitamente o tipo
+// da parada. Em kernels sem suporte, lê todos os registradores e confia em
+// expected_op (a alternância entrada/saída controlada pelo chamador).
+// Retorna 0 em caso de sucesso ou -1 se a thread não pôde ser lida.
+int syscall_stop_read(pid_t tid, int expected_op, struct syscall_stop *st);
+
+#endif
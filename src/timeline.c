@@ -0,0 +1,279 @@
+#include "timeline.h"
+#include "parser.h"
+#include "varint.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Threads cujo descritor de trilha (Perfetto) já foi gravado, por posição
+// direta (tid % TIMELINE_TIDS). Um tid que perde a posição tem o descritor
+// gravado de novo, igual ao anterior: a memória fica fixa.
+#define TIMELINE_TIDS 4096
+
+// Campos do protobuf do Perfetto (protos/perfetto/trace/...)
+#define PB_TRACE_PACKET            1   // Trace.packet
+#define PB_PACKET_TIMESTAMP        8   // TracePacket.timestamp
+#define PB_PACKET_SEQUENCE_ID      10  // TracePacket.trusted_packet_sequence_id
+#define PB_PACKET_TRACK_EVENT      11  // TracePacket.track_event
+#define PB_PACKET_SEQUENCE_FLAGS   13  // TracePacket.sequence_flags
+#define PB_PACKET_TRACK_DESCRIPTOR 60  // TracePacket.track_descriptor
+#define PB_TRACK_UUID              1   // TrackDescriptor.uuid
+#define PB_TRACK_PROCESS           3   // TrackDescriptor.process
+#define PB_TRACK_THREAD            4   // TrackDescriptor.thread
+#define PB_PROCESS_PID             1   // ProcessDescriptor.pid
+#define PB_PROCESS_NAME            6   // ProcessDescriptor.process_name
+#define PB_THREAD_PID              1   // ThreadDescriptor.pid
+#define PB_THREAD_TID              2   // ThreadDescriptor.tid
+#define PB_EVENT_ANNOTATION        4   // TrackEvent.debug_annotations
+#define PB_EVENT_TYPE              9   // TrackEvent.type
+#define PB_EVENT_TRACK_UUID        11  // TrackEvent.track_uuid
+#define PB_EVENT_CATEGORY          22  // TrackEvent.categories
+#define PB_EVENT_NAME              23  // TrackEvent.name
+#define PB_ANNOTATION_INT          4   // DebugAnnotation.int_value
+#define PB_ANNOTATION_POINTER      7   // DebugAnnotation.pointer_value
+#define PB_ANNOTATION_NAME         10  // DebugAnnotation.name
+
+#define PB_SLICE_BEGIN 1
+#define PB_SLICE_END   2
+#define PB_INSTANT     3
+#define PB_SEQ_INCREMENTAL_STATE_CLEARED 1
+#define PB_SEQ_NEEDS_INCREMENTAL_STATE   2
+
+// Trilha do processo; as das threads são TIMELINE_THREAD_UUID | tid
+#define TIMELINE_PROCESS_UUID 1
+#define TIMELINE_THREAD_UUID  0x100000000ULL
+#define TIMELINE_SEQUENCE     1
+
+// Maior pacote gravado: um evento com seis argumentos e o retorno
+#define PB_PACKET_MAX 512
+
+struct timeline_writer {
+    FILE *f;
+    enum timeline_format format;
+    struct trace_file_header hdr;
+    int failed;
+    int started;        // A primeira syscall (que define o pid) já foi gravada
+    uint32_t pid;
+    uint32_t tids[TIMELINE_TIDS];
+};
+
+static const char *const arg_names[6] = { "arg1", "arg2", "arg3", "arg4", "arg5", "arg6" };
+
+// --- Chrome trace event JSON ---
+
+/**
+ * @brief Escreve um valor como no log de texto: endereços (acima de 32 bits)
+ * em hexadecimal, como string (um double do JSON não guarda 64 bits).
+ */
+static void json_value(FILE *f, uint64_t v) {
+    int64_t sv = (int64_t) v;
+
+    if (sv < 0 && sv >= -(int64_t) 0x80000000LL) {
+        fprintf(f, "%lld", (long long) sv);
+    } else if (v > 0xffffffffULL) {
+        fprintf(f, "\"0x%llx\"", (unsigned long long) v);
+    } else {
+        fprintf(f, "%llu", (unsigned long long) v);
+    }
+}
+
+/**
+ * @brief Instante (ns) em microssegundos com três casas, a unidade do formato.
+ */
+static void json_us(FILE *f, uint64_t ns) {
+    fprintf(f, "%llu.%03u", (unsigned long long) (ns / 1000), (unsigned int) (ns % 1000));
+}
+
+static void json_add(struct timeline_writer *w, const struct trace_record *rec) {
+    FILE *f = w->f;
+
+    if (!w->started) {
+        fprintf(f, "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%u,\"args\":{\"name\":\"meu_logger\"}}", w->pid);
+    }
+    fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"syscall\",\"ph\":\"%s\",\"pid\":%u,\"tid\":%u,\"ts\":",
+            get_syscall_name_arch(w->hdr.arch, rec->nr), rec->flags & TRACE_F_EXIT ? "X" : "i", w->pid, rec->tid);
+    json_us(f, rec->ts_ns - w->hdr.start_monotonic_ns);
+    if (rec->flags & TRACE_F_EXIT) {
+        fputs(",\"dur\":", f);
+        json_us(f, rec->dur_ns);
+    } else {
+        fputs(",\"s\":\"t\"", f);
+    }
+    fputs(",\"args\":{", f);
+    for (int i = 0; i < 6; i++) {
+        fprintf(f, "%s\"%s\":", i ? "," : "", arg_names[i]);
+        json_value(f, rec->args[i]);
+    }
+    if (rec->flags & TRACE_F_EXIT) {
+        fputs(",\"ret\":", f);
+        json_value(f, (uint64_t) rec->ret);
+    }
+    fputs("}}", f);
+}
+
+// --- Protobuf do Perfetto ---
+
+static uint8_t *pb_varint(uint8_t *p, int field, uint64_t v) {
+    p = put_varint(p, (uint64_t) field << 3);
+    return put_varint(p, v);
+}
+
+static uint8_t *pb_bytes(uint8_t *p, int field, const void *data, size_t len) {
+    p = put_varint(p, (uint64_t) field << 3 | 2);
+    p = put_varint(p, len);
+    memcpy(p, data, len);
+    return p + len;
+}
+
+static uint8_t *pb_string(uint8_t *p, int field, const char *s) {
+    return pb_bytes(p, field, s, strlen(s));
+}
+
+/**
+ * @brief Grava um TracePacket (campo packet do Trace) com os campos já codificados.
+ */
+static void pb_packet(struct timeline_writer *w, const uint8_t *body, size_t len) {
+    uint8_t head[1 + VARINT_MAX];
+    uint8_t *p = put_varint(head, (uint64_t) PB_TRACE_PACKET << 3 | 2);
+
+    p = put_varint(p, len);
+    if (fwrite(head, 1, (size_t) (p - head), w->f) != (size_t) (p - head) || fwrite(body, 1, len, w->f) != len) {
+        w->failed = 1;
+    }
+}
+
+/**
+ * @brief Descritor de uma trilha: o processo (tid 0) ou uma thread.
+ */
+static void pb_track(struct timeline_writer *w, uint32_t tid) {
+    uint8_t desc[64], track[96], packet[128];
+    uint8_t *d = desc, *t = track, *p = packet;
+
+    if (tid == 0) {
+        d = pb_varint(d, PB_PROCESS_PID, w->pid);
+        d = pb_string(d, PB_PROCESS_NAME, "meu_logger");
+        t = pb_varint(t, PB_TRACK_UUID, TIMELINE_PROCESS_UUID);
+        t = pb_bytes(t, PB_TRACK_PROCESS, desc, (size_t) (d - desc));
+    } else {
+        d = pb_varint(d, PB_THREAD_PID, w->pid);
+        d = pb_varint(d, PB_THREAD_TID, tid);
+        t = pb_varint(t, PB_TRACK_UUID, TIMELINE_THREAD_UUID | tid);
+        t = pb_bytes(t, PB_TRACK_THREAD, desc, (size_t) (d - desc));
+    }
+    p = pb_varint(p, PB_PACKET_SEQUENCE_ID, TIMELINE_SEQUENCE);
+    p = pb_bytes(p, PB_PACKET_TRACK_DESCRIPTOR, track, (size_t) (t - track));
+    pb_packet(w, packet, (size_t) (p - packet));
+}
+
+static uint8_t *pb_annotation(uint8_t *p, const char *name, uint64_t v) {
+    uint8_t buf[32];
+    uint8_t *b = pb_string(buf, PB_ANNOTATION_NAME, name);
+    int64_t sv = (int64_t) v;
+
+    // Como no log de texto: endereços (acima de 32 bits) aparecem em hexadecimal
+    if (v > 0xffffffffULL && !(sv < 0 && sv >= -(int64_t) 0x80000000LL)) {
+        b = pb_varint(b, PB_ANNOTATION_POINTER, v);
+    } else {
+        b = pb_varint(b, PB_ANNOTATION_INT, v);
+    }
+    return pb_bytes(p, PB_EVENT_ANNOTATION, buf, (size_t) (b - buf));
+}
+
+/**
+ * @brief Grava um TrackEvent na trilha da thread; só o início leva nome e argumentos.
+ */
+static void pb_event(struct timeline_writer *w, const struct trace_record *rec, int type, uint64_t ts) {
+    uint8_t event[PB_PACKET_MAX], packet[PB_PACKET_MAX + 32];
+    uint8_t *e = event, *p = packet;
+
+    e = pb_varint(e, PB_EVENT_TYPE, (uint64_t) type);
+    e = pb_varint(e, PB_EVENT_TRACK_UUID, TIMELINE_THREAD_UUID | rec->tid);
+    if (type != PB_SLICE_END) {
+        e = pb_string(e, PB_EVENT_CATEGORY, "syscall");
+        e = pb_string(e, PB_EVENT_NAME, get_syscall_name_arch(w->hdr.arch, rec->nr));
+        for (int i = 0; i < 6; i++) {
+            e = pb_annotation(e, arg_names[i], rec->args[i]);
+        }
+        if (rec->flags & TRACE_F_EXIT) {
+            e = pb_annotation(e, "ret", (uint64_t) rec->ret);
+        }
+    }
+    p = pb_varint(p, PB_PACKET_TIMESTAMP, ts);
+    p = pb_varint(p, PB_PACKET_SEQUENCE_ID, TIMELINE_SEQUENCE);
+    p = pb_varint(p, PB_PACKET_SEQUENCE_FLAGS, PB_SEQ_NEEDS_INCREMENTAL_STATE);
+    p = pb_bytes(p, PB_PACKET_TRACK_EVENT, event, (size_t) (e - event));
+    pb_packet(w, packet, (size_t) (p - packet));
+}
+
+static void pb_add(struct timeline_writer *w, const struct trace_record *rec) {
+    uint64_t ts = rec->ts_ns - w->hdr.start_monotonic_ns;
+    uint32_t *slot = &w->tids[rec->tid % TIMELINE_TIDS];
+
+    if (!w->started) {
+        // Abre a sequência: os eventos dependem das trilhas declaradas nela
+        uint8_t packet[16];
+        uint8_t *p = pb_varint(packet, PB_PACKET_SEQUENCE_ID, TIMELINE_SEQUENCE);
+        p = pb_varint(p, PB_PACKET_SEQUENCE_FLAGS, PB_SEQ_INCREMENTAL_STATE_CLEARED);
+        pb_packet(w, packet, (size_t) (p - packet));
+        pb_track(w, 0);
+    }
+    if (*slot != rec->tid) {
+        pb_track(w, rec->tid);
+        *slot = rec->tid;
+    }
+    if (rec->flags & TRACE_F_EXIT) {
+        pb_event(w, rec, PB_SLICE_BEGIN, ts);
+        pb_event(w, rec, PB_SLICE_END, ts + rec->dur_ns);
+    } else {
+        pb_event(w, rec, PB_INSTANT, ts);
+    }
+}
+
+struct timeline_writer *timeline_open(const char *path, const struct trace_file_header *hdr,
+                                      enum timeline_format format) {
+    struct timeline_writer *w = calloc(1, sizeof(*w));
+
+    if (!w) {
+        return NULL;
+    }
+    w->f = fopen(path, "wb");
+    if (!w->f) {
+        free(w);
+        return NULL;
+    }
+    w->format = format;
+    w->hdr = *hdr;
+    if (format == TIMELINE_JSON) {
+        // A hora de parede do início fica nos metadados (os instantes são relativos a ele)
+        fprintf(w->f, "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"start_realtime_ns\":\"%llu\"},\n\"traceEvents\":[\n",
+                (unsigned long long) hdr->start_realtime_ns);
+    }
+    return w;
+}
+
+int timeline_add(struct timeline_writer *w, const struct trace_record *rec) {
+    if (!w->started) {
+        w->pid = rec->tid;
+    }
+    if (w->format == TIMELINE_JSON) {
+        json_add(w, rec);
+    } else {
+        pb_add(w, rec);
+    }
+    w->started = 1;
+    return w->failed || ferror(w->f) ? -1 : 0;
+}
+
+int timeline_close(struct timeline_writer *w) {
+    int status;
+
+    if (w->format == TIMELINE_JSON) {
+        fputs("\n]}\n", w->f);
+    }
+    status = w->failed || ferror(w->f) ? -1 : 0;
+    if (fclose(w->f) != 0) {
+        status = -1;
+    }
+    free(w);
+    return status;
+}
@@ -0,0 +1,35 @@
+#include <stdint.h>
+#include "trace_format.h"
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+// Exportação para linha do tempo (./bin/decode -J / -P): cada syscall vira
+// um evento com duração na trilha da sua thread, com o nome, os seis
+// argumentos e o retorno, para abrir no Perfetto (ui.perfetto.dev) ou no
+// chrome://tracing. Dois formatos:
+//  - TIMELINE_JSON: Chrome trace event JSON, eventos "X" (completos);
+//  - TIMELINE_PERFETTO: protobuf do Perfetto (TracePacket/TrackEvent), um par
+//    SLICE_BEGIN/SLICE_END por syscall, bem menor e mais rápido de carregar.
+// Os eventos são gravados um a um, na ordem do log: a memória não depende do
+// tamanho do rastreamento. Os instantes são relativos ao início do
+// rastreamento; o log não guarda o pid de cada thread, então todas ficam num
+// só processo, com o tid da primeira syscall do log. Syscalls sem a parada de
+// saída (exit_group) viram eventos instantâneos.
+
+enum timeline_format {
+    TIMELINE_JSON,
+    TIMELINE_PERFETTO
+};
+
+struct timeline_writer;
+
+// Cria o arquivo; retorna NULL (com errno) se não conseguir
+struct timeline_writer *timeline_open(const char *path, const struct trace_file_header *hdr,
+                                      enum timeline_format format);
+// Acrescenta uma syscall (registro comum; as repetições já expandidas)
+int timeline_add(struct timeline_writer *w, const struct trace_record *rec);
+// Fecha o arquivo. Retorna -1 se alguma escrita falhou.
+int timeline_close(struct timeline_writer *w);
+
+#endif
@@ -0,0 +1,102 @@
+#include <stdint.h>
+
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+
+// Formato binário do log (modo -b). O arquivo começa com um trace_file_header
+// e segue com registros trace_record de tamanho fixo, um por syscall, na
+// ordem em que as syscalls terminaram. Com os argumentos decodificados (-a),
+// um registro pode vir seguido dos dados dos seus ponteiros (TRACE_F_ARGS);
+// com a compactação de repetições (-z), um registro pode representar uma
+// sequência inteira de syscalls iguais (TRACE_F_REPEAT).
+// Todos os campos usam a ordem de bytes da máquina que gerou o log.
+
+#define TRACE_MAGIC "SCLGBIN"   // 8 bytes, incluindo o '\0'
+#define TRACE_VERSION 4   // 4: TRACE_F_REPEAT; 3: TRACE_F_ARGS; as versões 2 e 3 são lidas igual
+
+// Arquitetura do processo rastreado (define a tabela de nomes e os registradores)
+#define TRACE_ARCH_X86_64  1
+#define TRACE_ARCH_AARCH64 2
+
+#if defined(__x86_64__)
+    #define TRACE_ARCH_NATIVE TRACE_ARCH_X86_64
+#elif defined(__aarch64__)
+    #define TRACE_ARCH_NATIVE TRACE_ARCH_AARCH64
+#else
+    #error "Arquitetura não suportada."
+#endif
+
+struct trace_file_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t arch;
+    // Par de relógios lido no início do rastreamento. Os registros guardam
+    // apenas CLOCK_MONOTONIC; a hora de parede é obtida somando a diferença.
+    uint64_t start_realtime_ns;
+    uint64_t start_monotonic_ns;
+};
+
+// Bits de trace_record.flags
+#define TRACE_F_ENTRY 0x1 // Número e argumentos válidos (parada de entrada vista)
+#define TRACE_F_EXIT  0x2 // Valor de retorno válido (parada de saída vista)
+#define TRACE_F_ARGS  0x4 // Seguido de payload bytes de argumentos decodificados
+#define TRACE_F_PAD   0x8 // Posição vazia do buffer circular (nunca vai para o arquivo)
+#define TRACE_F_REPEAT 0x10 // Início de uma repetição compactada (-z); payload em struct trace_repeat
+#define TRACE_F_PAYLOAD (TRACE_F_ARGS | TRACE_F_REPEAT) // O registro é seguido de payload
+
+struct trace_record {
+    uint64_t ts_ns;   // CLOCK_MONOTONIC na entrada da syscall
+    uint32_t tid;
+    int32_t nr;       // Número da syscall
+    uint64_t args[6];
+    int64_t ret;
+    uint64_t dur_ns;  // Da parada de entrada à de saída (válido com TRACE_F_EXIT)
+    uint32_t flags;
+    uint32_t payload; // Bytes de payload que seguem o registro (com TRACE_F_PAYLOAD)
+};
+
+// Tipos de argumento de ponteiro (ver get_syscall_arg_types() em parser.h)
+#define TRACE_ARG_INT      0 // Valor comum: não é decodificado
+#define TRACE_ARG_PATH     1 // Caminho (string terminada em '\0')
+#define TRACE_ARG_BUF_IN   2 // Dados lidos pelo kernel; tamanho no argumento seguinte
+#define TRACE_ARG_BUF_OUT  3 // Dados escritos pelo kernel; tamanho no retorno
+#define TRACE_ARG_SOCKADDR 4 // struct sockaddr; tamanho no argumento seguinte
+#define TRACE_ARG_FD       5 // Descritor; os dados são o arquivo/socket a que ele se refere
+
+// trace_arg.arg do descritor devolvido no retorno (open, socket, dup...)
+#define TRACE_ARG_RET 6
+
+// Limite de payload de um registro (o logger nunca passa disso)
+#define TRACE_PAYLOAD_MAX 8192
+
+// O payload ocupa as posições seguintes ao registro, arredondado para um
+// número inteiro de sizeof(struct trace_record). É uma sequência de
+// trace_arg, cada um seguido de len bytes de dados e alinhado em 8 bytes.
+struct trace_arg {
+    uint8_t arg;       // Índice do argumento (0 a 5) ou TRACE_ARG_RET
+    uint8_t kind;      // TRACE_ARG_*
+    uint8_t truncated; // 1 se os dados foram cortados no limite de cópia
+    uint8_t reserved;
+    uint32_t len;      // Bytes de dados (caminhos sem o '\0')
+};
+
+// Payload de um registro com TRACE_F_REPEAT: o registro é o primeiro de
+// count syscalls iguais da mesma thread, em ciclos de period syscalls (um ciclo
+// de 1 é a mesma syscall repetida; de 3, epoll_wait/read/write...). Os outros
+// period - 1 registros do primeiro ciclo vêm inteiros logo depois do cabeçalho;
+// cada syscall seguinte repete o registro da sua posição no ciclo, com três
+// varints LEB128: ts_ns (diferença para a syscall anterior, zigzag), dur_ns e
+// ret (diferença para o do ciclo, zigzag). Os argumentos são sempre iguais.
+struct trace_repeat {
+    uint32_t period;
+    uint32_t count;   // Syscalls representadas, incluindo o primeiro ciclo
+    uint64_t span_ns; // Da entrada da primeira à saída da última
+};
+
+// Maior ciclo de uma repetição
+#define TRACE_REPEAT_PERIOD_MAX 4
+
+// Posições de registro ocupadas por um payload de len bytes
+#define TRACE_PAYLOAD_SLOTS(len) (((len) + sizeof(struct trace_record) - 1) / sizeof(struct trace_record))
+
+#endif
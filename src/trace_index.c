@@ -0,0 +1,472 @@
+#include "trace_index.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Lista de posições em construção
+struct posting_list {
+    int64_t key;
+    uint64_t count;
+    uint64_t cap;
+    uint64_t *offsets;
+};
+
+// Listas ordenadas pela chave (há poucas: uma por syscall ou por thread)
+struct posting_table {
+    struct posting_list *lists;
+    uint32_t count;
+    uint32_t cap;
+};
+
+// Segmento do índice em memória, enquanto é criado
+struct index_builder {
+    struct index_segment seg;
+    struct index_chunk *chunks;
+    uint32_t chunk_cap;
+    struct posting_table tables[2];
+    int failed; // Sem memória
+};
+
+const struct trace_record *trace_log_next(const uint8_t *log, size_t size, uint64_t *off, const void **payload) {
+    const struct trace_record *rec;
+    size_t len = sizeof(*rec);
+
+    if (*off > size || size - *off < sizeof(*rec)) {
+        return NULL;
+    }
+    rec = (const struct trace_record *) (log + *off);
+    if (rec->flags == 0) {
+        return NULL; // Todo registro tem TRACE_F_ENTRY ou TRACE_F_EXIT
+    }
+    *payload = NULL;
+    if (rec->flags & TRACE_F_PAYLOAD) {
+        if (rec->payload > TRACE_PAYLOAD_MAX) {
+            return NULL;
+        }
+        len += TRACE_PAYLOAD_SLOTS(rec->payload) * sizeof(*rec);
+        if (size - *off < len) {
+            return NULL;
+        }
+        *payload = rec + 1;
+    }
+    *off += len;
+    return rec;
+}
+
+/**
+ * @brief Lista da chave key, criada (na posição ordenada) se ainda não existe.
+ */
+static struct posting_list *table_get(struct posting_table *t, int64_t key) {
+    uint32_t lo = 0, hi = t->count;
+
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (t->lists[mid].key < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < t->count && t->lists[lo].key == key) {
+        return &t->lists[lo];
+    }
+    if (t->count == t->cap) {
+        uint32_t cap = t->cap ? 2 * t->cap : 64;
+        struct posting_list *lists = realloc(t->lists, cap * sizeof(*lists));
+        if (!lists) {
+            return NULL;
+        }
+        t->lists = lists;
+        t->cap = cap;
+    }
+    memmove(&t->lists[lo + 1], &t->lists[lo], (t->count - lo) * sizeof(t->lists[0]));
+    memset(&t->lists[lo], 0, sizeof(t->lists[0]));
+    t->lists[lo].key = key;
+    t->count++;
+    return &t->lists[lo];
+}
+
+static int list_add(struct posting_list *l, uint64_t off) {
+    // Uma repetição com a mesma syscall em duas posições do ciclo entra uma vez
+    if (l->count > 0 && l->offsets[l->count - 1] == off) {
+        return 0;
+    }
+    if (l->count == l->cap) {
+        uint64_t cap = l->cap ? 2 * l->cap : 16;
+        uint64_t *offsets = realloc(l->offsets, cap * sizeof(*offsets));
+        if (!offsets) {
+            return -1;
+        }
+        l->offsets = offsets;
+        l->cap = cap;
+    }
+    l->offsets[l->count++] = off;
+    return 0;
+}
+
+static void builder_add_key(struct index_builder *b, enum index_list list, int64_t key, uint64_t off) {
+    struct posting_list *l = table_get(&b->tables[list], key);
+
+    if (!l || list_add(l, off) == -1) {
+        b->failed = 1;
+    }
+}
+
+/**
+ * @brief Indexa o registro que começa em off.
+ */
+static void builder_add(struct index_builder *b, const struct trace_record *rec, const void *payload, uint64_t off) {
+    uint64_t end_ts = rec->ts_ns;
+    struct index_chunk *c;
+
+    builder_add_key(b, INDEX_BY_TID, rec->tid, off);
+    builder_add_key(b, INDEX_BY_NR, rec->nr, off);
+    if (rec->flags & TRACE_F_REPEAT && rec->payload >= sizeof(struct trace_repeat)) {
+        // A repetição entra na lista de cada syscall do ciclo
+        struct trace_repeat rep;
+        memcpy(&rep, payload, sizeof(rep));
+        for (uint32_t i = 1; i < rep.period && sizeof(rep) + i * sizeof(*rec) <= rec->payload; i++) {
+            struct trace_record next;
+            memcpy(&next, (const uint8_t *) payload + sizeof(rep) + (i - 1) * sizeof(next), sizeof(next));
+            builder_add_key(b, INDEX_BY_NR, next.nr, off);
+        }
+        end_ts = rec->ts_ns + rep.span_ns;
+    }
+
+    if (b->seg.records % INDEX_CHUNK == 0) {
+        if (b->seg.chunks == b->chunk_cap) {
+            uint32_t cap = b->chunk_cap ? 2 * b->chunk_cap : 64;
+            struct index_chunk *chunks = realloc(b->chunks, cap * sizeof(*chunks));
+            if (!chunks) {
+                b->failed = 1;
+                return;
+            }
+            b->chunks = chunks;
+            b->chunk_cap = cap;
+        }
+        c = &b->chunks[b->seg.chunks++];
+        c->offset = off;
+        c->min_ts = rec->ts_ns;
+        c->max_ts = end_ts;
+    } else {
+        c = &b->chunks[b->seg.chunks - 1];
+        c->min_ts = rec->ts_ns < c->min_ts ? rec->ts_ns : c->min_ts;
+        c->max_ts = end_ts > c->max_ts ? end_ts : c->max_ts;
+    }
+    b->seg.records++;
+}
+
+/**
+ * @brief Indexa os registros do log de [from, end) num segmento novo.
+ */
+static void builder_scan(struct index_builder *b, const uint8_t *log, size_t size, uint64_t from, uint64_t end) {
+    const struct trace_record *rec;
+    const void *payload;
+    uint64_t off = from;
+
+    b->seg.log_start = from;
+    while (!b->failed && off < end && (rec = trace_log_next(log, size, &off, &payload)) != NULL) {
+        builder_add(b, rec, payload, from);
+        from = off;
+    }
+    b->seg.log_end = from;
+}
+
+/**
+ * @brief Grava o segmento na posição atual de f; retorna o tamanho gravado ou -1.
+ */
+static long builder_write(struct index_builder *b, FILE *f) {
+    uint64_t first = 0;
+    int ok;
+
+    b->seg.nr_keys = b->tables[INDEX_BY_NR].count;
+    b->seg.tid_keys = b->tables[INDEX_BY_TID].count;
+    b->seg.postings = 0;
+    for (int list = 0; list < 2; list++) {
+        for (uint32_t k = 0; k < b->tables[list].count; k++) {
+            b->seg.postings += b->tables[list].lists[k].count;
+        }
+    }
+    ok = fwrite(&b->seg, sizeof(b->seg), 1, f) == 1;
+    ok = ok && fwrite(b->chunks, sizeof(b->chunks[0]), b->seg.chunks, f) == b->seg.chunks;
+    for (int list = 0; list < 2; list++) {
+        for (uint32_t k = 0; k < b->tables[list].count && ok; k++) {
+            const struct posting_list *l = &b->tables[list].lists[k];
+            struct index_key key = { l->key, l->count, first };
+            ok = fwrite(&key, sizeof(key), 1, f) == 1;
+            first += l->count;
+        }
+    }
+    for (int list = 0; list < 2; list++) {
+        for (uint32_t k = 0; k < b->tables[list].count && ok; k++) {
+            const struct posting_list *l = &b->tables[list].lists[k];
+            ok = fwrite(l->offsets, sizeof(uint64_t), l->count, f) == l->count;
+        }
+    }
+    if (!ok) {
+        return -1;
+    }
+    return (long) (sizeof(b->seg) + b->seg.chunks * sizeof(struct index_chunk) +
+                   ((size_t) b->seg.nr_keys + b->seg.tid_keys) * sizeof(struct index_key) +
+                   b->seg.postings * sizeof(uint64_t));
+}
+
+/**
+ * @brief Grava um índice novo, de um segmento só, num arquivo temporário e o
+ * troca pelo antigo de uma vez.
+ */
+static int index_create(struct index_builder *b, const char *path, const struct trace_file_header *log_hdr) {
+    char tmp[4096];
+    struct index_header hdr;
+    long size = 0;
+    FILE *f;
+    int ok;
+
+    if (snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int) sizeof(tmp) || !(f = fopen(tmp, "wb"))) {
+        return -1;
+    }
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, INDEX_MAGIC, sizeof(hdr.magic));
+    hdr.version = INDEX_VERSION;
+    hdr.segments = 1;
+    hdr.start_realtime_ns = log_hdr->start_realtime_ns;
+    hdr.start_monotonic_ns = log_hdr->start_monotonic_ns;
+    hdr.indexed_size = b->seg.log_end;
+    hdr.records = b->seg.records;
+    ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+    ok = ok && (size = builder_write(b, f)) != -1;
+    if (ok) {
+        // O cabeçalho vai de novo, agora com o tamanho do arquivo
+        hdr.file_size = sizeof(hdr) + (uint64_t) size;
+        ok = fseek(f, 0, SEEK_SET) == 0 && fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+    }
+    if (fclose(f) != 0 || !ok || rename(tmp, path) == -1) {
+        unlink(tmp);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Troca os segmentos a partir de seg_off pelo segmento em b, no lugar.
+ *
+ * O cabeçalho é regravado antes e depois: primeiro sem os segmentos que
+ * serão sobrescritos, depois com o novo. Se a extensão for interrompida no
+ * meio, o índice continua válido, só cobrindo um trecho menor do log.
+ */
+static int index_append(struct index_builder *b, const char *path, struct index_header hdr, uint32_t keep,
+                        uint64_t keep_records, uint64_t seg_off) {
+    long size = 0;
+    FILE *f;
+    int ok = 1;
+    int fd = open(path, O_RDWR);
+
+    if (fd == -1) {
+        return -1;
+    }
+    if (!(f = fdopen(fd, "r+b"))) {
+        close(fd);
+        return -1;
+    }
+    if (keep < hdr.segments) {
+        hdr.segments = keep;
+        hdr.indexed_size = b->seg.log_start;
+        hdr.records = keep_records;
+        hdr.file_size = seg_off;
+        ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1 && fflush(f) == 0;
+    }
+    ok = ok && fseeko(f, (off_t) seg_off, SEEK_SET) == 0 && (size = builder_write(b, f)) != -1;
+    ok = ok && fflush(f) == 0 && ftruncate(fd, (off_t) (seg_off + (uint64_t) size)) == 0;
+    if (ok) {
+        hdr.segments = keep + 1;
+        hdr.indexed_size = b->seg.log_end;
+        hdr.records = keep_records + b->seg.records;
+        hdr.file_size = seg_off + (uint64_t) size;
+        ok = fseeko(f, 0, SEEK_SET) == 0 && fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+    }
+    if (fclose(f) != 0 || !ok) {
+        return -1;
+    }
+    return 0;
+}
+
+static void builder_free(struct index_builder *b) {
+    for (int list = 0; list < 2; list++) {
+        for (uint32_t k = 0; k < b->tables[list].count; k++) {
+            free(b->tables[list].lists[k].offsets);
+        }
+        free(b->tables[list].lists);
+    }
+    free(b->chunks);
+}
+
+long trace_index_update(const char *path, const uint8_t *log, size_t log_size, int rebuild) {
+    const struct trace_file_header *log_hdr = (const struct trace_file_header *) log;
+    struct index_builder b;
+    struct index_header hdr;
+    struct trace_index old;
+    const void *payload;
+    uint64_t from = sizeof(*log_hdr), end, seg_off = 0, keep_records = 0;
+    uint32_t keep = 0;
+    long added = 0;
+
+    memset(&b, 0, sizeof(b));
+    if (!rebuild && trace_index_open(&old, path, log_hdr) == 0) {
+        // Um log que encolheu foi regravado: o índice é refeito do início
+        if (old.hdr->indexed_size > log_size) {
+            rebuild = 1;
+            trace_index_close(&old);
+        } else {
+            from = old.hdr->indexed_size;
+        }
+    } else {
+        rebuild = 1;
+    }
+
+    // Só conta os registros novos; com -m o log termina numa área de zeros, e
+    // um registro incompleto no fim ainda está sendo gravado
+    end = from;
+    while (trace_log_next(log, log_size, &end, &payload) != NULL) {
+        added++;
+    }
+    if (!rebuild) {
+        if (added == 0) {
+            trace_index_close(&old);
+            return 0; // Nada de novo no log
+        }
+        // O segmento novo absorve os últimos que não são maiores que ele
+        hdr = *old.hdr;
+        keep = hdr.segments;
+        keep_records = hdr.records;
+        for (uint64_t records = (uint64_t) added;
+             keep > 0 && old.segments[keep - 1].hdr->records <= records; keep--) {
+            records += old.segments[keep - 1].hdr->records;
+            keep_records -= old.segments[keep - 1].hdr->records;
+        }
+        if (keep < hdr.segments) {
+            from = old.segments[keep].hdr->log_start;
+            seg_off = (uint64_t) ((const uint8_t *) old.segments[keep].hdr - old.map);
+        } else {
+            seg_off = hdr.file_size;
+        }
+        // O mapeamento é privado: é desfeito antes de o arquivo ser regravado
+        trace_index_close(&old);
+    }
+
+    // Os segmentos absorvidos são refeitos a partir do log, que já está mapeado
+    builder_scan(&b, log, log_size, from, end);
+    if (b.failed) {
+        added = -1;
+    } else if (rebuild ? index_create(&b, path, log_hdr) == -1
+                       : index_append(&b, path, hdr, keep, keep_records, seg_off) == -1) {
+        added = -1;
+    }
+    builder_free(&b);
+    return added;
+}
+
+int trace_index_open(struct trace_index *ix, const char *path, const struct trace_file_header *hdr) {
+    struct stat st;
+    const struct index_header *h;
+    uint64_t pos, log_at = sizeof(*hdr), records = 0;
+    uint32_t i;
+    int fd = open(path, O_RDONLY);
+
+    if (fd == -1) {
+        return -1;
+    }
+    if (fstat(fd, &st) == -1 || (size_t) st.st_size < sizeof(*h)) {
+        close(fd);
+        return -1;
+    }
+    ix->size = (size_t) st.st_size;
+    ix->map = mmap(NULL, ix->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ix->map == MAP_FAILED) {
+        return -1;
+    }
+
+    // Mesmo log (pelos relógios do cabeçalho) e segmentos dentro do arquivo
+    h = (const struct index_header *) ix->map;
+    if (memcmp(h->magic, INDEX_MAGIC, sizeof(h->magic)) != 0 || h->version != INDEX_VERSION ||
+        h->start_realtime_ns != hdr->start_realtime_ns || h->start_monotonic_ns != hdr->start_monotonic_ns ||
+        h->file_size > ix->size || h->segments > h->file_size / sizeof(struct index_segment) ||
+        !(ix->segments = malloc((h->segments ? h->segments : 1) * sizeof(*ix->segments)))) {
+        munmap((void *) ix->map, ix->size);
+        return -1;
+    }
+    ix->hdr = h;
+
+    // Cada segmento continua o anterior no log e suas listas cabem nele
+    pos = sizeof(*h);
+    for (i = 0; i < h->segments; i++) {
+        struct trace_index_segment *seg = &ix->segments[i];
+        const struct index_segment *s = (const struct index_segment *) (ix->map + pos);
+        uint64_t need;
+        int ok = 1;
+
+        if (h->file_size - pos < sizeof(*s)) {
+            break;
+        }
+        need = sizeof(*s) + (uint64_t) s->chunks * sizeof(struct index_chunk) +
+               ((uint64_t) s->nr_keys + s->tid_keys) * sizeof(struct index_key);
+        if (need > h->file_size - pos || s->postings > (h->file_size - pos - need) / sizeof(uint64_t) ||
+            s->log_start != log_at || s->log_end < s->log_start || (s->chunks == 0 && s->postings != 0)) {
+            break;
+        }
+        seg->hdr = s;
+        seg->chunks = (const struct index_chunk *) (s + 1);
+        seg->keys[INDEX_BY_NR] = (const struct index_key *) (seg->chunks + s->chunks);
+        seg->keys[INDEX_BY_TID] = seg->keys[INDEX_BY_NR] + s->nr_keys;
+        seg->key_count[INDEX_BY_NR] = s->nr_keys;
+        seg->key_count[INDEX_BY_TID] = s->tid_keys;
+        seg->postings = (const uint64_t *) (seg->keys[INDEX_BY_TID] + s->tid_keys);
+        for (int list = 0; list < 2; list++) {
+            for (uint32_t k = 0; k < seg->key_count[list]; k++) {
+                const struct index_key *key = &seg->keys[list][k];
+                ok = ok && key->first <= s->postings && key->count <= s->postings - key->first;
+            }
+        }
+        if (!ok) {
+            break;
+        }
+        pos += need + s->postings * sizeof(uint64_t);
+        log_at = s->log_end;
+        records += s->records;
+    }
+    if (i < h->segments || pos != h->file_size || log_at != h->indexed_size || records != h->records) {
+        trace_index_close(ix);
+        return -1;
+    }
+    return 0;
+}
+
+const uint64_t *trace_index_find(const struct trace_index_segment *seg, enum index_list list, int64_t key,
+                                 uint64_t *count) {
+    const struct index_key *keys = seg->keys[list];
+    uint32_t lo = 0, hi = seg->key_count[list];
+
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (keys[mid].key < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < seg->key_count[list] && keys[lo].key == key) {
+        *count = keys[lo].count;
+        return seg->postings + keys[lo].first;
+    }
+    *count = 0;
+    return NULL;
+}
+
+void trace_index_close(struct trace_index *ix) {
+    free(ix->segments);
+    munmap((void *) ix->map, ix->size);
+}
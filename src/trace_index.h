@@ -0,0 +1,111 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "trace_format.h"
+
+#ifndef TRACE_INDEX_H
+#define TRACE_INDEX_H
+
+// Índice de um log binário, usado pelo bin/query. Fica num arquivo ao lado do
+// log (syscall_log.bin.idx) e é criado na primeira consulta; nas seguintes,
+// se o log cresceu (rastreamento ainda em andamento), só o trecho novo é
+// indexado. O índice guarda:
+//  - listas de posições (offsets dos registros no log, em ordem crescente)
+//    por número de syscall e por tid;
+//  - um índice esparso de tempo: a cada INDEX_CHUNK registros, o offset do
+//    primeiro e o menor/maior instante do trecho.
+// O arquivo é lido por mmap(): uma consulta só toca as listas que usa.
+//
+// O índice é uma sequência de segmentos, cada um com as listas e os trechos
+// de uma faixa contínua do log. Estender o índice acrescenta um segmento no
+// fim do arquivo e regrava só o cabeçalho: o que já foi indexado não é lido
+// nem reescrito. Para o número de segmentos não crescer com o número de
+// consultas, o segmento novo absorve os últimos enquanto eles não forem
+// maiores que ele (como num contador binário): cada segmento tem mais
+// registros que todos os seguintes juntos, então são O(log n) segmentos e
+// cada registro é regravado O(log n) vezes no total.
+
+#define INDEX_MAGIC "SCLGIDX"   // 8 bytes, incluindo o '\0'
+#define INDEX_VERSION 2
+#define INDEX_CHUNK 1024
+
+struct index_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t segments;
+    // Cópia dos relógios do cabeçalho do log: identifica o log indexado
+    uint64_t start_realtime_ns;
+    uint64_t start_monotonic_ns;
+    uint64_t indexed_size;   // Bytes do log cobertos (até o último registro completo)
+    uint64_t records;
+    // Bytes do índice em uso; o que vier depois é de uma extensão interrompida
+    uint64_t file_size;
+};
+
+// Cabeçalho de um segmento: cobre os registros de [log_start, log_end)
+struct index_segment {
+    uint64_t log_start;
+    uint64_t log_end;
+    uint64_t records;
+    uint64_t postings;  // Soma das listas
+    uint32_t chunks;
+    uint32_t nr_keys;
+    uint32_t tid_keys;
+    uint32_t reserved;
+};
+
+// Trecho de até INDEX_CHUNK registros
+struct index_chunk {
+    uint64_t offset;  // Do primeiro registro
+    uint64_t min_ts;
+    uint64_t max_ts;  // Inclui o fim das repetições (-z)
+};
+
+// Uma lista de posições: count offsets a partir de postings[first] do segmento
+struct index_key {
+    int64_t key;
+    uint64_t count;
+    uint64_t first;
+};
+
+// Depois do cabeçalho, os segmentos em ordem do log, cada um com
+// index_segment, chunks[chunks], chaves por nr[nr_keys] e por tid[tid_keys]
+// (ordenadas), e as listas (uint64_t) concatenadas.
+
+enum index_list {
+    INDEX_BY_NR,
+    INDEX_BY_TID
+};
+
+struct trace_index_segment {
+    const struct index_segment *hdr;
+    const struct index_chunk *chunks;
+    const struct index_key *keys[2]; // Por enum index_list
+    uint32_t key_count[2];
+    const uint64_t *postings;
+};
+
+struct trace_index {
+    const uint8_t *map;
+    size_t size;
+    const struct index_header *hdr;
+    struct trace_index_segment *segments; // hdr->segments
+};
+
+// Próximo registro do log mapeado a partir de *off (que avança); payload
+// recebe o payload (ou NULL). Retorna NULL no fim, num registro incompleto
+// ou numa área ainda não gravada (zeros, com -m durante o rastreamento).
+const struct trace_record *trace_log_next(const uint8_t *log, size_t size, uint64_t *off, const void **payload);
+
+// Cria o índice ou o estende até o fim atual do log (log: o arquivo inteiro
+// mapeado). rebuild: 1 ignora o índice existente. Retorna os registros
+// indexados agora, ou -1 se o índice não pôde ser gravado.
+long trace_index_update(const char *path, const uint8_t *log, size_t log_size, int rebuild);
+
+// Mapeia o índice; retorna -1 se ele não existe, está corrompido ou é de outro log
+int trace_index_open(struct trace_index *ix, const char *path, const struct trace_file_header *hdr);
+// Lista de posições da chave no segmento (NULL e *count = 0 se não há nenhuma)
+const uint64_t *trace_index_find(const struct trace_index_segment *seg, enum index_list list, int64_t key,
+                                 uint64_t *count);
+void trace_index_close(struct trace_index *ix);
+
+#endif
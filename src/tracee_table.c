@@ -0,0 +1,145 @@
+#include "tracee_table.h"
+#include "fdtable.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACEE_TABLE_MIN 64 // Capacidade inicial (sempre potência de 2)
+
+static struct tracee *slots = NULL;
+static size_t capacity = 0;
+static size_t used = 0;
+
+static size_t slot_of(pid_t tid) {
+    // Hash multiplicativo (Fibonacci): tids costumam ser sequenciais,
+    // então espalhamos os bits antes de aplicar a máscara.
+    return ((size_t) tid * 0x9E3779B97F4A7C15ULL) >> 32 & (capacity - 1);
+}
+
+static void grow(void) {
+    struct tracee *old = slots;
+    size_t old_capacity = capacity;
+
+    capacity = capacity ? capacity * 2 : TRACEE_TABLE_MIN;
+    slots = calloc(capacity, sizeof(*slots));
+    if (!slots) {
+        perror("calloc");
+        exit(1);
+    }
+
+    // Reinsere as entradas na nova tabela
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old[i].tid != 0) {
+            size_t j = slot_of(old[i].tid);
+            while (slots[j].tid != 0) {
+                j = (j + 1) & (capacity - 1);
+            }
+            slots[j] = old[i];
+        }
+    }
+    free(old);
+}
+
+struct tracee *tracee_find(pid_t tid) {
+    if (capacity == 0) {
+        return NULL;
+    }
+    for (size_t i = slot_of(tid); slots[i].tid != 0; i = (i + 1) & (capacity - 1)) {
+        if (slots[i].tid == tid) {
+            return &slots[i];
+        }
+    }
+    return NULL;
+}
+
+struct tracee *tracee_add(pid_t tid) {
+    struct tracee *t = tracee_find(tid);
+    size_t i;
+
+    if (t) {
+        return t;
+    }
+
+    // Mantém a ocupação abaixo de 50% para que as sondagens sejam curtas
+    if ((used + 1) * 2 > capacity) {
+        grow();
+    }
+
+    i = slot_of(tid);
+    while (slots[i].tid != 0) {
+        i = (i + 1) & (capacity - 1);
+    }
+    memset(&slots[i], 0, sizeof(slots[i]));
+    slots[i].tid = tid;
+    used++;
+    return &slots[i];
+}
+
+void tracee_remove(pid_t tid) {
+    struct tracee *t = tracee_find(tid);
+    size_t hole, i;
+
+    if (!t) {
+        return;
+    }
+
+    // Remoção com deslocamento para trás: puxa para o buraco as entradas
+    // seguintes do mesmo agrupamento, dispensando marcadores de "apagado".
+    hole = (size_t) (t - slots);
+    free(slots[hole].args);
+    slots[hole].args = NULL;
+    fdtable_put(slots[hole].fds);
+    slots[hole].fds = NULL;
+    slots[hole].tid = 0;
+    used--;
+
+    for (i = (hole + 1) & (capacity - 1); slots[i].tid != 0; i = (i + 1) & (capacity - 1)) {
+        size_t home = slot_of(slots[i].tid);
+        // A entrada pode ocupar o buraco se sua posição ideal não estiver
+        // (circularmente) entre o buraco e a posição atual.
+        if (((i - home) & (capacity - 1)) >= ((i - hole) & (capacity - 1))) {
+            slots[hole] = slots[i];
+            slots[i].tid = 0;
+            hole = i;
+        }
+    }
+}
+
+int tracee_count(void) {
+    return (int) used;
+}
+
+int tracee_tids(pid_t *tids, int max) {
+    int n = 0;
+
+    for (size_t i = 0; i < capacity && n < max; i++) {
+        if (slots[i].tid != 0) {
+            tids[n++] = slots[i].tid;
+        }
+    }
+    return n;
+}
+
+pid_t tracee_tgid(struct tracee *t) {
+    char path[64];
+    char line[128];
+    FILE *f;
+
+    if (t->tgid != 0) {
+        return t->tgid;
+    }
+
+    t->tgid = t->tid; // Se /proc não responder, a thread vira seu próprio grupo
+    snprintf(path, sizeof(path), "/proc/%d/status", (int) t->tid);
+    f = fopen(path, "r");
+    if (f) {
+        while (fgets(line, sizeof(line), f)) {
+            if (strncmp(line, "Tgid:", 5) == 0) {
+                t->tgid = (pid_t) atoi(line + 5);
+                break;
+            }
+        }
+        fclose(f);
+    }
+    return t->tgid;
+}
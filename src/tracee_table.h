@@ -0,0 +1,39 @@
+#include <sys/types.h>
+#include "trace_format.h"
+
+#ifndef TRACEE_TABLE_H
+#define TRACEE_TABLE_H
+
+struct arg_arena;
+struct fd_table;
+
+// Estado de rastreamento de uma thread (tid) monitorada.
+struct tracee {
+    pid_t tid;                    // 0 indica posição vazia na tabela
+    pid_t tgid;                   // Processo (grupo de threads); 0 enquanto desconhecido
+    int in_syscall;               // 1 entre a parada de entrada e a de saída
+    int attach_pending;           // 1 até o SIGSTOP inicial de uma thread/processo novo
+    int wake_pending;             // 1 até o SIGSTOP enviado pela amostragem (-w)
+    int sampled;                  // 1 se a syscall em andamento entrou na amostra
+    unsigned int sample_seq;      // Contador da amostragem 1 em N (-s)
+    struct trace_record rec;      // syscall em andamento (preenchido na entrada)
+    struct arg_arena *args;       // Argumentos decodificados (-a); liberado na remoção
+    struct fd_table *fds;         // Descritores do processo (-y); compartilhada pelas threads
+};
+
+// Tabela hash (endereçamento aberto) indexada pelo tid. Busca, inserção e
+// remoção são O(1) em média, independentemente da quantidade de threads.
+// Os ponteiros devolvidos só são válidos até a próxima inserção.
+struct tracee *tracee_find(pid_t tid);
+struct tracee *tracee_add(pid_t tid);
+void tracee_remove(pid_t tid);
+int tracee_count(void);
+
+// Copia para tids os tids rastreados (no máximo max) e retorna quantos copiou
+int tracee_tids(pid_t *tids, int max);
+
+// Processo (tgid) ao qual a thread pertence, lido de /proc/<tid>/status na
+// primeira consulta e guardado na própria entrada.
+pid_t tracee_tgid(struct tracee *t);
+
+#endif
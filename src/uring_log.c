@@ -0,0 +1,241 @@
+#define _GNU_SOURCE
+#include "uring_log.h"
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+static int sys_io_uring_setup(unsigned int entries, struct io_uring_params *p) {
+    return (int) syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int sys_io_uring_enter(int fd, unsigned int to_submit, unsigned int min_complete, unsigned int flags) {
+    return (int) syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+// Os índices das filas são compartilhados com o kernel: leituras do índice do
+// outro lado com acquire, publicação do nosso com release.
+static unsigned int load_acquire(unsigned int *p) {
+    return atomic_load_explicit((_Atomic unsigned int *) p, memory_order_acquire);
+}
+
+static void store_release(unsigned int *p, unsigned int v) {
+    atomic_store_explicit((_Atomic unsigned int *) p, v, memory_order_release);
+}
+
+/**
+ * @brief Trata as conclusões disponíveis; com wait, espera ao menos uma.
+ */
+static int reap(struct uring_log *u, int wait) {
+    unsigned int head, tail;
+
+    if (wait && sys_io_uring_enter(u->ring_fd, 0, 1, IORING_ENTER_GETEVENTS) == -1 && errno != EINTR) {
+        return -1;
+    }
+    head = *u->cq_head;
+    tail = load_acquire(u->cq_tail);
+    while (head != tail) {
+        struct io_uring_cqe *cqe = &u->cqes[head & *u->cq_mask];
+        int i = (int) cqe->user_data;
+        if (cqe->res < 0 || (size_t) cqe->res != u->iov[i].iov_len) {
+            u->errors++;
+            u->error = cqe->res < 0 ? -cqe->res : ENOSPC; // Escrita curta: disco cheio
+        }
+        u->busy[i] = 0;
+        u->in_flight--;
+        head++;
+    }
+    store_release(u->cq_head, head);
+    return 0;
+}
+
+/**
+ * @brief Submete a escrita do buffer atual e passa para o próximo livre.
+ */
+static int submit_current(struct uring_log *u, size_t len) {
+    unsigned int tail = *u->sq_tail;
+    unsigned int idx = tail & *u->sq_mask;
+    struct io_uring_sqe *sqe = &u->sqes[idx];
+    int i = u->cur;
+
+    u->iov[i].iov_base = u->buffers[i];
+    u->iov[i].iov_len = len;
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_WRITEV;   // Disponível desde o primeiro kernel com io_uring
+    sqe->fd = u->fd;
+    sqe->off = (uint64_t) u->cur_off;
+    sqe->addr = (uint64_t) (uintptr_t) &u->iov[i];
+    sqe->len = 1;
+    sqe->user_data = (uint64_t) i;
+    u->sq_array[idx] = idx;
+    store_release(u->sq_tail, tail + 1);
+
+    while (sys_io_uring_enter(u->ring_fd, 1, 0, 0) == -1) {
+        if (errno != EINTR && errno != EAGAIN) {
+            return -1;
+        }
+    }
+    u->busy[i] = 1;
+    u->in_flight++;
+
+    u->cur_off += (off_t) len;
+    u->cur = (u->cur + 1) % URING_LOG_BUFFERS;
+    u->fill = 0;
+
+    // Só bloqueia quando todos os buffers estão em voo
+    reap(u, 0);
+    while (u->busy[u->cur]) {
+        if (reap(u, 1) == -1) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int uring_log_open(struct uring_log *u, int fd, int direct) {
+    struct io_uring_params p;
+    int err;
+
+    memset(u, 0, sizeof(*u));
+    memset(&p, 0, sizeof(p));
+    u->fd = fd;
+    u->direct = direct;
+
+    u->ring_fd = sys_io_uring_setup(URING_LOG_BUFFERS, &p);
+    if (u->ring_fd == -1) {
+        return -1;
+    }
+
+    u->sq_map_len = p.sq_off.array + p.sq_entries * sizeof(unsigned int);
+    u->cq_map_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (u->cq_map_len > u->sq_map_len) {
+            u->sq_map_len = u->cq_map_len;
+        }
+        u->cq_map_len = u->sq_map_len;
+    }
+    u->sq_map = mmap(NULL, u->sq_map_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     u->ring_fd, IORING_OFF_SQ_RING);
+    if (u->sq_map == MAP_FAILED) {
+        goto fail;
+    }
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        u->cq_map = u->sq_map;
+    } else {
+        u->cq_map = mmap(NULL, u->cq_map_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         u->ring_fd, IORING_OFF_CQ_RING);
+        if (u->cq_map == MAP_FAILED) {
+            goto fail;
+        }
+    }
+    u->sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+    u->sqes = mmap(NULL, u->sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   u->ring_fd, IORING_OFF_SQES);
+    if (u->sqes == MAP_FAILED) {
+        u->sqes = NULL;
+        goto fail;
+    }
+
+    u->sq_head = (unsigned int *) ((char *) u->sq_map + p.sq_off.head);
+    u->sq_tail = (unsigned int *) ((char *) u->sq_map + p.sq_off.tail);
+    u->sq_mask = (unsigned int *) ((char *) u->sq_map + p.sq_off.ring_mask);
+    u->sq_array = (unsigned int *) ((char *) u->sq_map + p.sq_off.array);
+    u->cq_head = (unsigned int *) ((char *) u->cq_map + p.cq_off.head);
+    u->cq_tail = (unsigned int *) ((char *) u->cq_map + p.cq_off.tail);
+    u->cq_mask = (unsigned int *) ((char *) u->cq_map + p.cq_off.ring_mask);
+    u->cqes = (struct io_uring_cqe *) ((char *) u->cq_map + p.cq_off.cqes);
+
+    for (int i = 0; i < URING_LOG_BUFFERS; i++) {
+        if (posix_memalign((void **) &u->buffers[i], URING_LOG_ALIGN, URING_LOG_BUFFER_SIZE) != 0) {
+            errno = ENOMEM;
+            goto fail;
+        }
+    }
+    return 0;
+
+fail:
+    err = errno;
+    for (int i = 0; i < URING_LOG_BUFFERS; i++) {
+        free(u->buffers[i]);
+    }
+    if (u->sqes) {
+        munmap(u->sqes, u->sqes_len);
+    }
+    if (u->cq_map && u->cq_map != MAP_FAILED && u->cq_map != u->sq_map) {
+        munmap(u->cq_map, u->cq_map_len);
+    }
+    if (u->sq_map && u->sq_map != MAP_FAILED) {
+        munmap(u->sq_map, u->sq_map_len);
+    }
+    close(u->ring_fd);
+    errno = err;
+    return -1;
+}
+
+int uring_log_write(struct uring_log *u, const void *buf, size_t len, size_t *copied) {
+    const char *src = buf;
+
+    *copied = 0;
+    while (len > 0) {
+        size_t n = URING_LOG_BUFFER_SIZE - u->fill;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(u->buffers[u->cur] + u->fill, src, n);
+        u->fill += n;
+        src += n;
+        len -= n;
+        *copied += n;
+        if (u->fill == URING_LOG_BUFFER_SIZE && submit_current(u, URING_LOG_BUFFER_SIZE) == -1) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int uring_log_close(struct uring_log *u) {
+    off_t end = u->cur_off + (off_t) u->fill;
+    int ret = 0;
+
+    if (u->fill > 0) {
+        size_t len = u->fill;
+        if (u->direct) {
+            // O_DIRECT só aceita tamanhos alinhados: completa com zeros e trunca depois
+            len = (len + URING_LOG_ALIGN - 1) & ~((size_t) URING_LOG_ALIGN - 1);
+            memset(u->buffers[u->cur] + u->fill, 0, len - u->fill);
+        }
+        if (submit_current(u, len) == -1) {
+            ret = -1;
+        }
+    }
+    while (u->in_flight > 0) {
+        if (reap(u, 1) == -1) {
+            ret = -1;
+            break;
+        }
+    }
+    if (u->errors > 0) {
+        errno = u->error;
+        ret = -1;
+    }
+    if (ftruncate(u->fd, end) == -1) {
+        ret = -1;
+    }
+
+    for (int i = 0; i < URING_LOG_BUFFERS; i++) {
+        free(u->buffers[i]);
+    }
+    munmap(u->sqes, u->sqes_len);
+    if (u->cq_map != u->sq_map) {
+        munmap(u->cq_map, u->cq_map_len);
+    }
+    munmap(u->sq_map, u->sq_map_len);
+    close(u->ring_fd);
+    return ret;
+}
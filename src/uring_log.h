@@ -0,0 +1,55 @@
+#include <stddef.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#ifndef URING_LOG_H
+#define URING_LOG_H
+
+// Gravação do log por io_uring (modo -u), com syscalls diretas (sem liburing).
+// Os dados são acumulados em URING_LOG_BUFFERS buffers alinhados de
+// URING_LOG_BUFFER_SIZE bytes; cada buffer cheio vira uma escrita assíncrona
+// e a thread de escrita passa para o próximo, só esperando o kernel quando
+// todos estão em voo. Com O_DIRECT, o último buffer é completado com zeros
+// até o alinhamento e o arquivo é truncado no tamanho real no fechamento.
+#define URING_LOG_BUFFERS 8
+#define URING_LOG_BUFFER_SIZE (1024 * 1024)
+#define URING_LOG_ALIGN 4096   // Alinhamento de endereço, tamanho e posição exigido pelo O_DIRECT
+
+struct uring_log {
+    int ring_fd;
+    int fd;
+    int direct;
+
+    // Fila de submissão (SQ) e de conclusão (CQ), mapeadas do kernel
+    unsigned int *sq_head, *sq_tail, *sq_mask, *sq_array;
+    struct io_uring_sqe *sqes;
+    unsigned int *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_cqe *cqes;
+    void *sq_map, *cq_map;
+    size_t sq_map_len, cq_map_len, sqes_len;
+
+    char *buffers[URING_LOG_BUFFERS];
+    struct iovec iov[URING_LOG_BUFFERS];
+    int busy[URING_LOG_BUFFERS];   // 1 enquanto a escrita do buffer está em voo
+    int in_flight;
+    int cur;          // Buffer sendo preenchido
+    size_t fill;      // Bytes no buffer atual
+    off_t cur_off;    // Posição no arquivo do início do buffer atual
+    int errors;       // Escritas que falharam ou ficaram incompletas
+    int error;        // errno da última delas
+};
+
+// Prepara a fila e os buffers para gravar em fd a partir da posição 0.
+// direct: fd foi aberto com O_DIRECT. Retorna -1 (com errno) se o kernel não
+// tem io_uring ou ele está desabilitado; nada precisa ser desfeito nesse caso.
+int uring_log_open(struct uring_log *u, int fd, int direct);
+
+// Copia len bytes para os buffers, submetendo os que enchem. copied recebe
+// os bytes que ficaram com a fila (mesmo em erro: uring_log_close() os grava).
+int uring_log_write(struct uring_log *u, const void *buf, size_t len, size_t *copied);
+
+// Submete o que sobrou, espera todas as escritas e libera a fila.
+// Retorna 0, ou -1 se alguma escrita falhou.
+int uring_log_close(struct uring_log *u);
+
+#endif
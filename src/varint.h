@@ -0,0 +1,46 @@
+#include <stdint.h>
+
+#ifndef VARINT_H
+#define VARINT_H
+
+// Inteiros de tamanho variável (LEB128): 7 bits por byte, o bit alto marca
+// continuação. Usados nas repetições compactadas (-z), no formato colunar e no
+// protobuf da exportação para o Perfetto.
+
+// Maior varint de 64 bits, em bytes
+#define VARINT_MAX 10
+
+static inline uint8_t *put_varint(uint8_t *p, uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = (uint8_t) (v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t) v;
+    return p;
+}
+
+// Lê um varint de [*p, end); retorna -1 se ele passar do fim
+static inline int get_varint(const uint8_t **p, const uint8_t *end, uint64_t *v) {
+    uint64_t value = 0;
+
+    for (int shift = 0; *p < end && shift < 64; shift += 7) {
+        uint8_t byte = *(*p)++;
+        value |= (uint64_t) (byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            *v = value;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// Diferenças com sinal: 0, -1, 1, -2... viram 0, 1, 2, 3...
+static inline uint64_t zigzag(int64_t v) {
+    return ((uint64_t) v << 1) ^ (uint64_t) (v >> 63);
+}
+
+static inline int64_t unzigzag(uint64_t v) {
+    return (int64_t) (v >> 1) ^ -(int64_t) (v & 1);
+}
+
+#endif
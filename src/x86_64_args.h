@@ -0,0 +1,102 @@
+case 0: return SYSCALL_ARGS(FD, BUF_OUT, INT, INT, INT, INT); // read
+case 1: return SYSCALL_ARGS(FD, BUF_IN, INT, INT, INT, INT); // write
+case 2: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // open
+case 3: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // close
+case 4: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // stat
+case 5: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fstat
+case 6: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // lstat
+case 8: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // lseek
+case 9: return SYSCALL_ARGS(INT, INT, INT, INT, FD, INT); // mmap
+case 16: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // ioctl
+case 17: return SYSCALL_ARGS(FD, BUF_OUT, INT, INT, INT, INT); // pread64
+case 18: return SYSCALL_ARGS(FD, BUF_IN, INT, INT, INT, INT); // pwrite64
+case 19: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // readv
+case 20: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // writev
+case 21: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // access
+case 32: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // dup
+case 33: return SYSCALL_ARGS(FD, FD, INT, INT, INT, INT); // dup2
+case 40: return SYSCALL_ARGS(FD, FD, INT, INT, INT, INT); // sendfile
+case 42: return SYSCALL_ARGS(FD, SOCKADDR, INT, INT, INT, INT); // connect
+case 43: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // accept
+case 44: return SYSCALL_ARGS(FD, BUF_IN, INT, INT, SOCKADDR, INT); // sendto
+case 45: return SYSCALL_ARGS(FD, BUF_OUT, INT, INT, INT, INT); // recvfrom
+case 46: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // sendmsg
+case 47: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // recvmsg
+case 48: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // shutdown
+case 49: return SYSCALL_ARGS(FD, SOCKADDR, INT, INT, INT, INT); // bind
+case 50: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // listen
+case 51: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // getsockname
+case 52: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // getpeername
+case 54: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // setsockopt
+case 55: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // getsockopt
+case 59: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // execve
+case 72: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fcntl
+case 73: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // flock
+case 74: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fsync
+case 75: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fdatasync
+case 76: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // truncate
+case 77: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // ftruncate
+case 78: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // getdents
+case 80: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // chdir
+case 81: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fchdir
+case 82: return SYSCALL_ARGS(PATH, PATH, INT, INT, INT, INT); // rename
+case 83: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // mkdir
+case 84: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // rmdir
+case 85: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // creat
+case 86: return SYSCALL_ARGS(PATH, PATH, INT, INT, INT, INT); // link
+case 87: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // unlink
+case 88: return SYSCALL_ARGS(PATH, PATH, INT, INT, INT, INT); // symlink
+case 89: return SYSCALL_ARGS(PATH, BUF_OUT, INT, INT, INT, INT); // readlink
+case 90: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // chmod
+case 91: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fchmod
+case 92: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // chown
+case 93: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fchown
+case 94: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // lchown
+case 137: return SYSCALL_ARGS(PATH, INT, INT, INT, INT, INT); // statfs
+case 138: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fstatfs
+case 187: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // readahead
+case 190: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fsetxattr
+case 193: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fgetxattr
+case 196: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // flistxattr
+case 199: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fremovexattr
+case 217: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // getdents64
+case 221: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fadvise64
+case 232: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // epoll_wait
+case 233: return SYSCALL_ARGS(FD, INT, FD, INT, INT, INT); // epoll_ctl
+case 254: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // inotify_add_watch
+case 255: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // inotify_rm_watch
+case 257: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // openat
+case 258: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // mkdirat
+case 260: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // fchownat
+case 262: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // newfstatat
+case 263: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // unlinkat
+case 264: return SYSCALL_ARGS(FD, PATH, FD, PATH, INT, INT); // renameat
+case 265: return SYSCALL_ARGS(FD, PATH, FD, PATH, INT, INT); // linkat
+case 266: return SYSCALL_ARGS(PATH, FD, PATH, INT, INT, INT); // symlinkat
+case 267: return SYSCALL_ARGS(FD, PATH, BUF_OUT, INT, INT, INT); // readlinkat
+case 268: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // fchmodat
+case 269: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // faccessat
+case 275: return SYSCALL_ARGS(FD, INT, FD, INT, INT, INT); // splice
+case 276: return SYSCALL_ARGS(FD, FD, INT, INT, INT, INT); // tee
+case 277: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // sync_file_range
+case 278: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // vmsplice
+case 280: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // utimensat
+case 281: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // epoll_pwait
+case 285: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // fallocate
+case 286: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // timerfd_settime
+case 287: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // timerfd_gettime
+case 288: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // accept4
+case 292: return SYSCALL_ARGS(FD, FD, INT, INT, INT, INT); // dup3
+case 295: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // preadv
+case 296: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // pwritev
+case 299: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // recvmmsg
+case 303: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // name_to_handle_at
+case 306: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // syncfs
+case 307: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // sendmmsg
+case 308: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // setns
+case 316: return SYSCALL_ARGS(FD, PATH, FD, PATH, INT, INT); // renameat2
+case 322: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // execveat
+case 326: return SYSCALL_ARGS(FD, INT, FD, INT, INT, INT); // copy_file_range
+case 327: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // preadv2
+case 328: return SYSCALL_ARGS(FD, INT, INT, INT, INT, INT); // pwritev2
+case 332: return SYSCALL_ARGS(FD, PATH, INT, INT, INT, INT); // statx
@@ -0,0 +1,204 @@
+case 0: return SYSCALL_CLASS_DESC; // read
+case 1: return SYSCALL_CLASS_DESC; // write
+case 2: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // open
+case 3: return SYSCALL_CLASS_DESC; // close
+case 4: return SYSCALL_CLASS_FILE; // stat
+case 5: return SYSCALL_CLASS_DESC; // fstat
+case 6: return SYSCALL_CLASS_FILE; // lstat
+case 7: return SYSCALL_CLASS_DESC; // poll
+case 8: return SYSCALL_CLASS_DESC; // lseek
+case 9: return SYSCALL_CLASS_DESC | SYSCALL_CLASS_MEMORY; // mmap
+case 10: return SYSCALL_CLASS_MEMORY; // mprotect
+case 11: return SYSCALL_CLASS_MEMORY; // munmap
+case 12: return SYSCALL_CLASS_MEMORY; // brk
+case 13: return SYSCALL_CLASS_SIGNAL; // rt_sigaction
+case 14: return SYSCALL_CLASS_SIGNAL; // rt_sigprocmask
+case 15: return SYSCALL_CLASS_SIGNAL; // rt_sigreturn
+case 16: return SYSCALL_CLASS_DESC; // ioctl
+case 17: return SYSCALL_CLASS_DESC; // pread64
+case 18: return SYSCALL_CLASS_DESC; // pwrite64
+case 19: return SYSCALL_CLASS_DESC; // readv
+case 20: return SYSCALL_CLASS_DESC; // writev
+case 21: return SYSCALL_CLASS_FILE; // access
+case 22: return SYSCALL_CLASS_DESC; // pipe
+case 23: return SYSCALL_CLASS_DESC; // select
+case 25: return SYSCALL_CLASS_MEMORY; // mremap
+case 26: return SYSCALL_CLASS_MEMORY; // msync
+case 27: return SYSCALL_CLASS_MEMORY; // mincore
+case 28: return SYSCALL_CLASS_MEMORY; // madvise
+case 29: return SYSCALL_CLASS_IPC; // shmget
+case 30: return SYSCALL_CLASS_IPC; // shmat
+case 31: return SYSCALL_CLASS_IPC; // shmctl
+case 32: return SYSCALL_CLASS_DESC; // dup
+case 33: return SYSCALL_CLASS_DESC; // dup2
+case 34: return SYSCALL_CLASS_SIGNAL; // pause
+case 40: return SYSCALL_CLASS_DESC; // sendfile
+case 41: return SYSCALL_CLASS_NETWORK; // socket
+case 42: return SYSCALL_CLASS_NETWORK; // connect
+case 43: return SYSCALL_CLASS_NETWORK; // accept
+case 44: return SYSCALL_CLASS_NETWORK; // sendto
+case 45: return SYSCALL_CLASS_NETWORK; // recvfrom
+case 46: return SYSCALL_CLASS_NETWORK; // sendmsg
+case 47: return SYSCALL_CLASS_NETWORK; // recvmsg
+case 48: return SYSCALL_CLASS_NETWORK; // shutdown
+case 49: return SYSCALL_CLASS_NETWORK; // bind
+case 50: return SYSCALL_CLASS_NETWORK; // listen
+case 51: return SYSCALL_CLASS_NETWORK; // getsockname
+case 52: return SYSCALL_CLASS_NETWORK; // getpeername
+case 53: return SYSCALL_CLASS_NETWORK; // socketpair
+case 54: return SYSCALL_CLASS_NETWORK; // setsockopt
+case 55: return SYSCALL_CLASS_NETWORK; // getsockopt
+case 56: return SYSCALL_CLASS_PROCESS; // clone
+case 57: return SYSCALL_CLASS_PROCESS; // fork
+case 58: return SYSCALL_CLASS_PROCESS; // vfork
+case 59: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_PROCESS; // execve
+case 60: return SYSCALL_CLASS_PROCESS; // exit
+case 61: return SYSCALL_CLASS_PROCESS; // wait4
+case 62: return SYSCALL_CLASS_PROCESS | SYSCALL_CLASS_SIGNAL; // kill
+case 64: return SYSCALL_CLASS_IPC; // semget
+case 65: return SYSCALL_CLASS_IPC; // semop
+case 66: return SYSCALL_CLASS_IPC; // semctl
+case 67: return SYSCALL_CLASS_IPC; // shmdt
+case 68: return SYSCALL_CLASS_IPC; // msgget
+case 69: return SYSCALL_CLASS_IPC; // msgsnd
+case 70: return SYSCALL_CLASS_IPC; // msgrcv
+case 71: return SYSCALL_CLASS_IPC; // msgctl
+case 72: return SYSCALL_CLASS_DESC; // fcntl
+case 73: return SYSCALL_CLASS_DESC; // flock
+case 74: return SYSCALL_CLASS_DESC; // fsync
+case 75: return SYSCALL_CLASS_DESC; // fdatasync
+case 76: return SYSCALL_CLASS_FILE; // truncate
+case 77: return SYSCALL_CLASS_DESC; // ftruncate
+case 78: return SYSCALL_CLASS_DESC; // getdents
+case 80: return SYSCALL_CLASS_FILE; // chdir
+case 81: return SYSCALL_CLASS_DESC; // fchdir
+case 82: return SYSCALL_CLASS_FILE; // rename
+case 83: return SYSCALL_CLASS_FILE; // mkdir
+case 84: return SYSCALL_CLASS_FILE; // rmdir
+case 85: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // creat
+case 86: return SYSCALL_CLASS_FILE; // link
+case 87: return SYSCALL_CLASS_FILE; // unlink
+case 88: return SYSCALL_CLASS_FILE; // symlink
+case 89: return SYSCALL_CLASS_FILE; // readlink
+case 90: return SYSCALL_CLASS_FILE; // chmod
+case 91: return SYSCALL_CLASS_DESC; // fchmod
+case 92: return SYSCALL_CLASS_FILE; // chown
+case 93: return SYSCALL_CLASS_DESC; // fchown
+case 94: return SYSCALL_CLASS_FILE; // lchown
+case 127: return SYSCALL_CLASS_SIGNAL; // rt_sigpending
+case 128: return SYSCALL_CLASS_SIGNAL; // rt_sigtimedwait
+case 129: return SYSCALL_CLASS_PROCESS | SYSCALL_CLASS_SIGNAL; // rt_sigqueueinfo
+case 130: return SYSCALL_CLASS_SIGNAL; // rt_sigsuspend
+case 131: return SYSCALL_CLASS_SIGNAL; // sigaltstack
+case 132: return SYSCALL_CLASS_FILE; // utime
+case 133: return SYSCALL_CLASS_FILE; // mknod
+case 134: return SYSCALL_CLASS_FILE; // uselib
+case 137: return SYSCALL_CLASS_FILE; // statfs
+case 138: return SYSCALL_CLASS_DESC; // fstatfs
+case 149: return SYSCALL_CLASS_MEMORY; // mlock
+case 150: return SYSCALL_CLASS_MEMORY; // munlock
+case 151: return SYSCALL_CLASS_MEMORY; // mlockall
+case 152: return SYSCALL_CLASS_MEMORY; // munlockall
+case 155: return SYSCALL_CLASS_FILE; // pivot_root
+case 161: return SYSCALL_CLASS_FILE; // chroot
+case 163: return SYSCALL_CLASS_FILE; // acct
+case 165: return SYSCALL_CLASS_FILE; // mount
+case 166: return SYSCALL_CLASS_FILE; // umount2
+case 167: return SYSCALL_CLASS_FILE; // swapon
+case 168: return SYSCALL_CLASS_FILE; // swapoff
+case 179: return SYSCALL_CLASS_FILE; // quotactl
+case 187: return SYSCALL_CLASS_DESC; // readahead
+case 188: return SYSCALL_CLASS_FILE; // setxattr
+case 189: return SYSCALL_CLASS_FILE; // lsetxattr
+case 190: return SYSCALL_CLASS_DESC; // fsetxattr
+case 191: return SYSCALL_CLASS_FILE; // getxattr
+case 192: return SYSCALL_CLASS_FILE; // lgetxattr
+case 193: return SYSCALL_CLASS_DESC; // fgetxattr
+case 194: return SYSCALL_CLASS_FILE; // listxattr
+case 195: return SYSCALL_CLASS_FILE; // llistxattr
+case 196: return SYSCALL_CLASS_DESC; // flistxattr
+case 197: return SYSCALL_CLASS_FILE; // removexattr
+case 198: return SYSCALL_CLASS_FILE; // lremovexattr
+case 199: return SYSCALL_CLASS_DESC; // fremovexattr
+case 200: return SYSCALL_CLASS_PROCESS | SYSCALL_CLASS_SIGNAL; // tkill
+case 213: return SYSCALL_CLASS_DESC; // epoll_create
+case 216: return SYSCALL_CLASS_MEMORY; // remap_file_pages
+case 217: return SYSCALL_CLASS_DESC; // getdents64
+case 220: return SYSCALL_CLASS_IPC; // semtimedop
+case 221: return SYSCALL_CLASS_DESC; // fadvise64
+case 231: return SYSCALL_CLASS_PROCESS; // exit_group
+case 232: return SYSCALL_CLASS_DESC; // epoll_wait
+case 233: return SYSCALL_CLASS_DESC; // epoll_ctl
+case 234: return SYSCALL_CLASS_PROCESS | SYSCALL_CLASS_SIGNAL; // tgkill
+case 235: return SYSCALL_CLASS_FILE; // utimes
+case 237: return SYSCALL_CLASS_MEMORY; // mbind
+case 238: return SYSCALL_CLASS_MEMORY; // set_mempolicy
+case 239: return SYSCALL_CLASS_MEMORY; // get_mempolicy
+case 240: return SYSCALL_CLASS_IPC; // mq_open
+case 241: return SYSCALL_CLASS_IPC; // mq_unlink
+case 242: return SYSCALL_CLASS_IPC; // mq_timedsend
+case 243: return SYSCALL_CLASS_IPC; // mq_timedreceive
+case 244: return SYSCALL_CLASS_IPC; // mq_notify
+case 245: return SYSCALL_CLASS_IPC; // mq_getsetattr
+case 247: return SYSCALL_CLASS_PROCESS; // waitid
+case 253: return SYSCALL_CLASS_DESC; // inotify_init
+case 254: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // inotify_add_watch
+case 255: return SYSCALL_CLASS_DESC; // inotify_rm_watch
+case 256: return SYSCALL_CLASS_MEMORY; // migrate_pages
+case 257: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // openat
+case 258: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // mkdirat
+case 259: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // mknodat
+case 260: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // fchownat
+case 261: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // futimesat
+case 262: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // newfstatat
+case 263: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // unlinkat
+case 264: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // renameat
+case 265: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // linkat
+case 266: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // symlinkat
+case 267: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // readlinkat
+case 268: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // fchmodat
+case 269: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // faccessat
+case 270: return SYSCALL_CLASS_DESC; // pselect6
+case 271: return SYSCALL_CLASS_DESC; // ppoll
+case 272: return SYSCALL_CLASS_PROCESS; // unshare
+case 275: return SYSCALL_CLASS_DESC; // splice
+case 276: return SYSCALL_CLASS_DESC; // tee
+case 277: return SYSCALL_CLASS_DESC; // sync_file_range
+case 278: return SYSCALL_CLASS_DESC; // vmsplice
+case 279: return SYSCALL_CLASS_MEMORY; // move_pages
+case 280: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // utimensat
+case 281: return SYSCALL_CLASS_DESC; // epoll_pwait
+case 282: return SYSCALL_CLASS_DESC | SYSCALL_CLASS_SIGNAL; // signalfd
+case 283: return SYSCALL_CLASS_DESC; // timerfd_create
+case 284: return SYSCALL_CLASS_DESC; // eventfd
+case 285: return SYSCALL_CLASS_DESC; // fallocate
+case 286: return SYSCALL_CLASS_DESC; // timerfd_settime
+case 287: return SYSCALL_CLASS_DESC; // timerfd_gettime
+case 288: return SYSCALL_CLASS_NETWORK; // accept4
+case 289: return SYSCALL_CLASS_DESC | SYSCALL_CLASS_SIGNAL; // signalfd4
+case 290: return SYSCALL_CLASS_DESC; // eventfd2
+case 291: return SYSCALL_CLASS_DESC; // epoll_create1
+case 292: return SYSCALL_CLASS_DESC; // dup3
+case 293: return SYSCALL_CLASS_DESC; // pipe2
+case 294: return SYSCALL_CLASS_DESC; // inotify_init1
+case 295: return SYSCALL_CLASS_DESC; // preadv
+case 296: return SYSCALL_CLASS_DESC; // pwritev
+case 297: return SYSCALL_CLASS_PROCESS | SYSCALL_CLASS_SIGNAL; // rt_tgsigqueueinfo
+case 299: return SYSCALL_CLASS_NETWORK; // recvmmsg
+case 300: return SYSCALL_CLASS_DESC; // fanotify_init
+case 301: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // fanotify_mark
+case 303: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // name_to_handle_at
+case 304: return SYSCALL_CLASS_DESC; // open_by_handle_at
+case 306: return SYSCALL_CLASS_DESC; // syncfs
+case 307: return SYSCALL_CLASS_NETWORK; // sendmmsg
+case 308: return SYSCALL_CLASS_DESC; // setns
+case 313: return SYSCALL_CLASS_DESC; // finit_module
+case 316: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // renameat2
+case 319: return SYSCALL_CLASS_DESC; // memfd_create
+case 322: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC | SYSCALL_CLASS_PROCESS; // execveat
+case 325: return SYSCALL_CLASS_MEMORY; // mlock2
+case 326: return SYSCALL_CLASS_DESC; // copy_file_range
+case 327: return SYSCALL_CLASS_DESC; // preadv2
+case 328: return SYSCALL_CLASS_DESC; // pwritev2
+case 329: return SYSCALL_CLASS_MEMORY; // pkey_mprotect
+case 332: return SYSCALL_CLASS_FILE | SYSCALL_CLASS_DESC; // statx
@@ -0,0 +1,80 @@
+#!/bin/sh
+# Benchmark do custo do rastreamento (make bench).
+#
+# Roda cada carga de tests/bench/workload.c sem o logger e com o logger em cada
+# modo, e imprime por linha:
+#   - ns/syscall: tempo do laço da carga dividido pelo número de syscalls
+#   - custo ns/syscall: diferença para a execução sem rastreamento
+#   - eventos/s: syscalls da carga concluídas por segundo
+#   - bytes/evento: tamanho do log dividido pelos registros gravados
+#
+# Variáveis de ambiente:
+#   BENCH_N      iterações de cada carga (padrão 100000; futex usa N/4)
+#   BENCH_MODES  modos a medir (padrão: "texto silencioso binario mmap uring direto resumo filtrado argumentos compactado")
+#   LOGGER       executável do logger (padrão: bin/meu_logger)
+
+ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+LOGGER=${LOGGER:-$ROOT/bin/meu_logger}
+WORKLOAD=$ROOT/bin/workload
+N=${BENCH_N:-100000}
+MODES=${BENCH_MODES:-"texto silencioso binario mmap uring direto resumo filtrado argumentos compactado"}
+
+# Os logs são gravados no diretório atual; não sobrescreve os do usuário
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+cd "$DIR" || exit 1
+
+# Syscall principal de cada carga, usada no modo filtrado (-f)
+main_syscall() {
+    case $1 in
+        getpid) echo getpid ;;
+        pipe) echo write ;;
+        open) echo openat ;;
+        futex) echo futex ;;
+    esac
+}
+
+mode_options() {
+    case $1 in
+        texto) echo "" ;;
+        silencioso) echo "-q" ;;
+        binario) echo "-b" ;;
+        mmap) echo "-b -m" ;;
+        uring) echo "-b -u" ;;
+        direto) echo "-b -U" ;;
+        resumo) echo "-c" ;;
+        filtrado) echo "-f $(main_syscall "$2")" ;;
+        argumentos) echo "-q -a 64" ;;
+        compactado) echo "-b -z" ;;
+    esac
+}
+
+printf "%-7s %-9s %11s %11s %12s %13s\n" carga modo ns/syscall "custo ns" eventos/s bytes/evento
+printf "%-7s %-9s %11s %11s %12s %13s\n" ------- --------- ----------- ----------- ------------ -------------
+
+for load in getpid pipe open futex; do
+    n=$N
+    [ "$load" = futex ] && n=$((N / 4))
+
+    "$WORKLOAD" "$load" "$n" result.txt || exit 1
+    read -r calls base_ns < result.txt
+    awk -v c="$calls" -v ns="$base_ns" -v load="$load" \
+        'BEGIN { printf "%-7s %-9s %11.1f %11s %12.0f %13s\n", load, "nativo", ns / c, "-", c * 1e9 / ns, "-" }'
+
+    for mode in $MODES; do
+        rm -f syscall_log.txt syscall_log.bin
+        # shellcheck disable=SC2046
+        "$LOGGER" $(mode_options "$mode" "$load") "$WORKLOAD" "$load" "$n" result.txt > logger.txt 2>&1 || exit 1
+        read -r calls ns < result.txt
+
+        # "Registros gravados: N" é impresso pelo logger ao fechar o log
+        records=$(sed -n 's/.*Registros gravados: \([0-9]*\).*/\1/p' logger.txt)
+        size=$(cat syscall_log.txt syscall_log.bin 2>/dev/null | wc -c)
+
+        awk -v c="$calls" -v ns="$ns" -v base="$base_ns" -v load="$load" -v mode="$mode" \
+            -v size="$size" -v recs="${records:-0}" 'BEGIN {
+            per_event = recs > 0 ? sprintf("%.1f", size / recs) : "-"
+            printf "%-7s %-9s %11.1f %11.1f %12.0f %13s\n", load, mode, ns / c, (ns - base) / c, c * 1e9 / ns, per_event
+        }'
+    done
+done
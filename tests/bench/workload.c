@@ -0,0 +1,180 @@
+/**
+ * =====================================================================================
+ *
+ * Filename:  workload.c
+ *
+ * Description:  Cargas de trabalho do benchmark (make bench). Cada modo executa
+ * um laço curto dominado por uma syscall e mede só o tempo do laço, para que a
+ * inicialização do processo (e do logger) não entre na conta.
+ *
+ * Uso: workload <getpid|pipe|open|futex> <iterações> <arquivo de resultado>
+ * O resultado é uma linha "syscalls nanossegundos", gravada no arquivo (e não
+ * no stdout, que o logger também usa).
+ *
+ * Team:  Sérgio, Joel, Gustavo e Vinícius
+ * * =====================================================================================
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+// --- getpid: o custo mínimo de uma syscall ---
+
+static long run_getpid(long n)
+{
+    for (long i = 0; i < n; i++)
+    {
+        syscall(SYS_getpid); // Sem o cache da glibc: sempre entra no kernel
+    }
+    return n;
+}
+
+// --- pipe: write + read de 1 byte ---
+
+static long run_pipe(long n)
+{
+    int fds[2];
+    char c = 'x';
+
+    if (pipe(fds) < 0)
+    {
+        perror("pipe");
+        exit(1);
+    }
+    for (long i = 0; i < n; i++)
+    {
+        if (write(fds[1], &c, 1) != 1 || read(fds[0], &c, 1) != 1)
+        {
+            perror("pipe");
+            exit(1);
+        }
+    }
+    close(fds[0]);
+    close(fds[1]);
+    return 2 * n;
+}
+
+// --- open: openat + close, com argumento de caminho ---
+
+static long run_open(long n)
+{
+    for (long i = 0; i < n; i++)
+    {
+        int fd = openat(AT_FDCWD, "/dev/null", O_RDONLY);
+        if (fd < 0)
+        {
+            perror("openat");
+            exit(1);
+        }
+        close(fd);
+    }
+    return 2 * n;
+}
+
+// --- futex: duas threads se revezando (ping-pong) ---
+
+static atomic_int turn;   // 0: vez da thread principal; 1: vez da outra
+static long rounds;
+
+static void futex_wait(atomic_int *addr, int val)
+{
+    syscall(SYS_futex, (int *) addr, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0);
+}
+
+static void futex_wake(atomic_int *addr)
+{
+    syscall(SYS_futex, (int *) addr, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+static void pass_turn(int mine)
+{
+    // Espera a própria vez, passa para a outra thread e a acorda
+    while (atomic_load(&turn) != mine)
+    {
+        futex_wait(&turn, !mine);
+    }
+    atomic_store(&turn, !mine);
+    futex_wake(&turn);
+}
+
+static void *pong(void *arg)
+{
+    (void) arg;
+    for (long i = 0; i < rounds; i++)
+    {
+        pass_turn(1);
+    }
+    return NULL;
+}
+
+static long run_futex(long n)
+{
+    pthread_t th;
+
+    rounds = n;
+    atomic_store(&turn, 0);
+    pthread_create(&th, NULL, pong, NULL);
+    for (long i = 0; i < n; i++)
+    {
+        pass_turn(0);
+    }
+    pthread_join(th, NULL);
+    // Cada volta faz ao menos um FUTEX_WAKE em cada thread; as esperas variam
+    return 2 * n;
+}
+
+int main(int argc, char *argv[])
+{
+    long n, calls;
+    uint64_t start, elapsed;
+    FILE *out;
+
+    if (argc != 4)
+    {
+        fprintf(stderr, "Uso: %s <getpid|pipe|open|futex> <iterações> <arquivo de resultado>\n", argv[0]);
+        return 1;
+    }
+    n = atol(argv[2]);
+
+    start = now_ns();
+    if (strcmp(argv[1], "getpid") == 0)
+        calls = run_getpid(n);
+    else if (strcmp(argv[1], "pipe") == 0)
+        calls = run_pipe(n);
+    else if (strcmp(argv[1], "open") == 0)
+        calls = run_open(n);
+    else if (strcmp(argv[1], "futex") == 0)
+        calls = run_futex(n);
+    else
+    {
+        fprintf(stderr, "Carga desconhecida: %s\n", argv[1]);
+        return 1;
+    }
+    elapsed = now_ns() - start;
+
+    out = fopen(argv[3], "w");
+    if (!out)
+    {
+        perror("Erro ao abrir o arquivo de resultado");
+        return 1;
+    }
+    fprintf(out, "%ld %llu\n", calls, (unsigned long long) elapsed);
+    fclose(out);
+    return 0;
+}